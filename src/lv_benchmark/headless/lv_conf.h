@@ -0,0 +1,134 @@
+/**
+ * @file lv_conf.h
+ * LittlevGL configuration of the headless benchmark.
+ * Everything not set here gets its default value from `lv_conf_checker.h`.
+ */
+
+#if 1 /*Set it to "1" to enable content*/
+
+#ifndef LV_CONF_H
+#define LV_CONF_H
+
+#include <stdint.h>
+
+/*====================
+   Graphical settings
+ *====================*/
+
+/* Maximal horizontal and vertical resolution to support by the library.*/
+#define LV_HOR_RES_MAX          (1280)
+#define LV_VER_RES_MAX          (720)
+
+/* Color depth: 1, 8, 16 or 32. Can be overridden from the command line*/
+#ifndef LV_COLOR_DEPTH
+#define LV_COLOR_DEPTH          16
+#endif
+
+#define LV_COLOR_16_SWAP        0
+
+/* 1: Enable anti-aliasing. Can be overridden from the command line*/
+#ifndef LV_ANTIALIAS
+#define LV_ANTIALIAS            1
+#endif
+
+/* Default display refresh period [ms]. Kept short to not wait for the panel*/
+#define LV_DISP_DEF_REFR_PERIOD 10
+
+#define LV_DPI                  100
+
+typedef int16_t lv_coord_t;
+
+/*=========================
+   Memory manager settings
+ *=========================*/
+
+#define LV_MEM_CUSTOM           0
+/* Size of the `lv_mem` heap [bytes]. Large enough for the object scaling test.
+ * Can be overridden from the command line to measure the fragmentation of a small heap*/
+#ifndef LV_MEM_SIZE
+#define LV_MEM_SIZE             (8U * 1024U * 1024U)
+#endif
+
+/*=======================
+   Input device settings
+ *=======================*/
+
+#define LV_INDEV_DEF_READ_PERIOD    10
+
+/*==================
+ * Feature usage
+ *==================*/
+
+#define LV_USE_ANIMATION        1
+typedef void * lv_anim_user_data_t;
+
+#define LV_USE_SHADOW           1
+#define LV_USE_GROUP            1
+typedef void * lv_group_user_data_t;
+
+#define LV_USE_FILESYSTEM       1
+typedef void * lv_fs_drv_user_data_t;
+
+#define LV_USE_USER_DATA        1
+
+/*========================
+ * Image decoder and cache
+ *========================*/
+
+#define LV_IMG_CF_INDEXED       1
+#define LV_IMG_CF_ALPHA         1
+#define LV_IMG_CACHE_DEF_SIZE   1
+typedef void * lv_img_decoder_user_data_t;
+
+/*=====================
+ *  Compiler settings
+ *====================*/
+
+#define LV_BIG_ENDIAN_SYSTEM    0
+
+/*===================
+ *  HAL settings
+ *==================*/
+
+/* Take the tick from the host's monotonic clock (see `lv_benchmark_headless.c`)*/
+#define LV_TICK_CUSTOM     1
+#define LV_TICK_CUSTOM_INCLUDE  <stdint.h>
+#define LV_TICK_CUSTOM_SYS_TIME_EXPR (benchmark_headless_tick_get())
+uint32_t benchmark_headless_tick_get(void);
+
+typedef void * lv_disp_drv_user_data_t;
+typedef void * lv_indev_drv_user_data_t;
+
+/*================
+ * Log settings
+ *===============*/
+
+#define LV_USE_LOG      0
+
+/*==================
+ *    FONT USAGE
+ *===================*/
+
+#define LV_FONT_ROBOTO_12    1
+#define LV_FONT_ROBOTO_16    1
+#define LV_FONT_ROBOTO_22    1
+#define LV_FONT_ROBOTO_28    1
+
+#define LV_FONT_DEFAULT        &lv_font_roboto_16
+
+typedef void * lv_font_user_data_t;
+
+/*===================
+ *  LV_OBJ SETTINGS
+ *==================*/
+
+typedef void * lv_obj_user_data_t;
+
+/*--END OF LV_CONF_H--*/
+
+/*Be sure every define has a default value*/
+#include "lvgl/src/lv_conf_checker.h"
+
+#endif /*LV_CONF_H*/
+
+#endif /*End of "Content enable"*/
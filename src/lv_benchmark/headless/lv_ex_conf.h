@@ -0,0 +1,24 @@
+/**
+ * @file lv_ex_conf.h
+ * Configuration of the headless benchmark. Only the benchmark is built.
+ */
+
+#ifndef LV_EX_CONF_H
+#define LV_EX_CONF_H
+
+#define LV_EX_PRINTF       0
+#define LV_EX_KEYBOARD     0
+#define LV_EX_MOUSEWHEEL   0
+
+#define LV_USE_TESTS        0
+#define LV_USE_TUTORIALS    0
+
+/*Applications*/
+#define LV_USE_BENCHMARK            1
+#define LV_USE_BENCHMARK_HEADLESS   1
+#define LV_USE_DEMO                 0
+#define LV_USE_SYSMON               0
+#define LV_USE_TERMINAL             0
+#define LV_USE_TPCAL                0
+
+#endif /*LV_EX_CONF_H*/
@@ -0,0 +1,348 @@
+/**
+ * @file main.c
+ * Run the graphics benchmark without a display and print the result as JSON.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stdlib.h>
+#include <unistd.h>
+#include "lv_benchmark_headless.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define DEF_HOR_RES     480
+#define DEF_VER_RES     320
+#define DEF_TIMEOUT     60000   /*[ms]. The animated scenes get this much more than their total time.*/
+#define DEF_BUF_FLUSH   400     /*Flush time of `-u` without `-f`: 16 bit pixels on a 40 MHz SPI [ns/px]*/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void usage(const char * prog);
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int main(int argc, char ** argv)
+{
+    int hres_arg = DEF_HOR_RES;     /*Parsed as `int` to not wrap around in `lv_coord_t` before the check*/
+    int vres_arg = DEF_VER_RES;
+    uint32_t timeout = DEF_TIMEOUT;
+    bool timeout_set = false;
+    const char * out_path = NULL;
+    const char * base_path = NULL;
+    const char * trace_path = NULL;
+    int threshold = BENCHMARK_HEADLESS_DEF_THRESHOLD;
+    bool matrix = false;
+    bool sweep = false;
+    bool buf_sweep = false;
+    bool table = false;
+    int flush_time = 0;
+    bool flush_set = false;
+    bool scenes = false;
+    bool anim = false;
+    bool engine = false;
+    bool dirty = false;
+    bool text = false;
+    bool img = false;
+    bool objs = false;
+    bool layout = false;
+    bool style_mod = false;
+    bool latency = false;
+    bool tasks = false;
+    int anim_time = BENCHMARK_DEF_ANIM_TIME;
+    int warmup = BENCHMARK_DEF_WARMUP_NUM;
+    int sample = BENCHMARK_DEF_SAMPLE_NUM;
+
+    int opt;
+    while((opt = getopt(argc, argv, "x:y:t:o:b:e:r:mpusavicgjlkqzd:w:n:f:Th")) != -1) {
+        switch(opt) {
+            case 'x':
+                hres_arg = atoi(optarg);
+                break;
+            case 'y':
+                vres_arg = atoi(optarg);
+                break;
+            case 't':
+                timeout = atoi(optarg);
+                timeout_set = true;
+                break;
+            case 'o':
+                out_path = optarg;
+                break;
+            case 'b':
+                base_path = optarg;
+                break;
+            case 'e':
+                trace_path = optarg;
+                break;
+            case 'r':
+                threshold = atoi(optarg);
+                break;
+            case 'm':
+                matrix = true;
+                break;
+            case 'p':
+                sweep = true;
+                break;
+            case 'u':
+                buf_sweep = true;
+                break;
+            case 's':
+                scenes = true;
+                break;
+            case 'a':
+                anim = true;
+                break;
+            case 'v':
+                engine = true;
+                break;
+            case 'i':
+                dirty = true;
+                break;
+            case 'g':
+                text = true;
+                break;
+            case 'j':
+                img = true;
+                break;
+            case 'c':
+                objs = true;
+                break;
+            case 'l':
+                layout = true;
+                break;
+            case 'k':
+                style_mod = true;
+                break;
+            case 'q':
+                latency = true;
+                break;
+            case 'z':
+                tasks = true;
+                break;
+            case 'd':
+                anim_time = atoi(optarg);
+                break;
+            case 'w':
+                warmup = atoi(optarg);
+                break;
+            case 'n':
+                sample = atoi(optarg);
+                break;
+            case 'f':
+                flush_time = atoi(optarg);
+                flush_set = true;
+                break;
+            case 'T':
+                table = true;
+                break;
+            default:
+                usage(argv[0]);
+                return opt == 'h' ? 0 : 2;
+        }
+    }
+
+    /*The modes run different tests so only one of them can be used*/
+    int mode_cnt = matrix + sweep + buf_sweep + scenes + text + img + dirty + anim + engine +
+                   objs + layout + latency + style_mod + tasks;
+    if(mode_cnt > 1) {
+        fprintf(stderr, "Use only one of -m, -p, -u, -s, -g, -j, -i, -a, -v, -q, -c, -l, -k and -z\n");
+        usage(argv[0]);
+        return 2;
+    }
+
+    /*Only print the results of earlier runs*/
+    if(table) {
+        if(benchmark_headless_table((const char * const *)&argv[optind], argc - optind, stdout) < 0) {
+            fprintf(stderr, "Couldn't read the result files\n");
+            return 1;
+        }
+        return 0;
+    }
+
+    if(hres_arg <= 0 || vres_arg <= 0 || hres_arg > LV_HOR_RES_MAX || vres_arg > LV_VER_RES_MAX) {
+        fprintf(stderr, "Invalid resolution: %dx%d (max. %dx%d)\n", hres_arg, vres_arg, LV_HOR_RES_MAX, LV_VER_RES_MAX);
+        return 2;
+    }
+
+    lv_coord_t hres = (lv_coord_t)hres_arg;
+    lv_coord_t vres = (lv_coord_t)vres_arg;
+
+    if(warmup < 0 || sample <= 0 || sample > BENCHMARK_SAMPLE_MAX) {
+        fprintf(stderr, "Invalid sample number: %d (max. %d)\n", sample, BENCHMARK_SAMPLE_MAX);
+        return 2;
+    }
+
+    if(anim_time <= 0) {
+        fprintf(stderr, "Invalid animation time: %d ms\n", anim_time);
+        return 2;
+    }
+
+    if(threshold < 0) {
+        fprintf(stderr, "Invalid threshold: %d%%\n", threshold);
+        return 2;
+    }
+
+    if(flush_time < 0) {
+        fprintf(stderr, "Invalid flush time: %d ns/px\n", flush_time);
+        return 2;
+    }
+
+    /*With an instant flush one and two buffers would be the same*/
+    if(buf_sweep && flush_set == false) flush_time = DEF_BUF_FLUSH;
+
+    lv_init();
+
+    benchmark_set_clock_cb(benchmark_headless_clock_ns);
+
+    if(benchmark_headless_cnt_open() > 0) {
+        benchmark_set_cnt_cb(benchmark_headless_cnt_read);
+    } else {
+        fprintf(stderr, "Hardware counters are not available, measuring the time only\n");
+    }
+
+#if BENCHMARK_HEADLESS_MEM_WRAP
+    benchmark_set_mem_cnt_cb(benchmark_headless_mem_cnt_read);
+    benchmark_set_mem_peak_cb(benchmark_headless_mem_peak_read);
+#endif
+
+    benchmark_set_sample_num(warmup, sample);
+    benchmark_set_anim_time(anim_time);
+    benchmark_headless_set_flush_time(flush_time);
+
+    if(trace_path && benchmark_headless_trace_start() == false) {
+        fprintf(stderr, "Couldn't allocate the trace buffer\n");
+        return 1;
+    }
+
+    /*The sweeps create their own displays*/
+    lv_disp_t * disp = NULL;
+    if(sweep == false && buf_sweep == false) {
+        disp = benchmark_headless_disp_create(hres, vres);
+        if(disp == NULL) {
+            fprintf(stderr, "Couldn't allocate the display buffers\n");
+            return 1;
+        }
+
+        benchmark_create();
+    }
+
+    if(sweep) {
+        /*Runs synchronously*/
+        if(benchmark_headless_sweep(NULL, 0, timeout) == 0) {
+            fprintf(stderr, "The resolution sweep failed\n");
+            return 1;
+        }
+    } else if(buf_sweep) {
+        /*Runs synchronously*/
+        if(benchmark_headless_buf_sweep(hres, vres, timeout) == 0) {
+            fprintf(stderr, "The draw buffer sweep failed\n");
+            return 1;
+        }
+    } else if(matrix) {
+        benchmark_start_matrix();
+    } else if(scenes) {
+        uint16_t cnt;
+        const benchmark_scene_t * prim = benchmark_get_prim_scenes(&cnt);
+        benchmark_start_scenes(prim, cnt);
+    } else if(text) {
+        uint16_t cnt;
+        const benchmark_scene_t * text_scenes = benchmark_get_text_scenes(&cnt);
+        benchmark_start_scenes(text_scenes, cnt);
+    } else if(img) {
+        uint16_t cnt;
+        const benchmark_scene_t * img_scenes = benchmark_get_img_scenes(&cnt);
+        benchmark_start_scenes(img_scenes, cnt);
+    } else if(dirty) {
+        uint16_t cnt;
+        const benchmark_scene_t * dirty_scenes = benchmark_get_dirty_scenes(&cnt);
+        benchmark_start_dirty(dirty_scenes, cnt);
+    } else if(anim) {
+        uint16_t cnt;
+        const benchmark_scene_t * anim_scenes = benchmark_get_anim_scenes(&cnt);
+        benchmark_start_anim(anim_scenes, cnt);
+        if(timeout_set == false) timeout = (uint32_t)anim_time * cnt + DEF_TIMEOUT;
+    } else if(engine) {
+        uint16_t cnt;
+        const benchmark_scene_t * engine_scenes = benchmark_get_anim_engine_scenes(&cnt);
+        benchmark_start_anim(engine_scenes, cnt);
+        if(timeout_set == false) timeout = (uint32_t)anim_time * cnt + DEF_TIMEOUT;
+    } else if(objs) {
+        /*Runs synchronously*/
+        benchmark_run_obj_scaling(NULL, 0);
+    } else if(layout) {
+        /*Runs synchronously*/
+        benchmark_run_layout(NULL, 0);
+    } else if(latency) {
+        benchmark_start_latency();
+    } else if(style_mod) {
+        /*Runs synchronously*/
+        benchmark_run_style_mod(NULL, 0);
+    } else if(tasks) {
+        /*Runs synchronously and calls `lv_task_handler()` itself*/
+        benchmark_run_tasks(NULL, 0);
+    } else {
+        benchmark_start();
+    }
+
+    if(sweep == false && buf_sweep == false && objs == false && layout == false && style_mod == false && tasks == false &&
+       benchmark_headless_run(timeout) == false) {
+        fprintf(stderr, "The benchmark didn't finish in %u ms\n", (unsigned int)timeout);
+        return 1;
+    }
+
+    FILE * f = stdout;
+    if(out_path) {
+        f = fopen(out_path, "w");
+        if(f == NULL) {
+            perror(out_path);
+            return 1;
+        }
+    }
+
+    benchmark_headless_write_json(f);
+
+    if(f != stdout) fclose(f);
+
+    if(trace_path) {
+        FILE * tf = fopen(trace_path, "w");
+        if(tf == NULL) {
+            perror(trace_path);
+            return 1;
+        }
+        benchmark_headless_trace_write(tf);
+        fclose(tf);
+    }
+
+    int ret = 0;
+    if(base_path) {
+        int32_t slower_cnt = benchmark_headless_compare(base_path, threshold, stderr);
+        if(slower_cnt < 0) {
+            fprintf(stderr, "Couldn't read the baseline: %s\n", base_path);
+            ret = 1;
+        } else if(slower_cnt > 0) {
+            fprintf(stderr, "%d test(s) got slower by more than %d%%\n", (int)slower_cnt, threshold);
+            ret = 3;
+        }
+    }
+
+    benchmark_headless_cnt_close();
+    if(disp) benchmark_headless_disp_del(disp);
+
+    return ret;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void usage(const char * prog)
+{
+    fprintf(stderr, "Usage: %s [-x hor_res] [-y ver_res] [-t timeout_ms] [-w warmup] [-n samples] [-f flush_ns_per_px] [-m | -p | -u | -s | -g | -j | -i | -a | -v | -q | -c | -l | -k | -z] [-d anim_ms] [-o result.json] [-e trace.json] [-b baseline.json] [-r threshold_pct]\n", prog);
+    fprintf(stderr, "       %s -T result1.json result2.json ...\n", prog);
+}
@@ -6,18 +6,21 @@
 /*********************
  *      INCLUDES
  *********************/
-#include "lv_benchmark.h"
+#include "lv_benchmark_internal.h"
 #if LV_USE_BENCHMARK
 
 #include <stdio.h>
+#include <string.h>
 
 /*********************
  *      DEFINES
  *********************/
-#define TEST_CYCLE_NUM  10              /*How many times run the test (will calculate the average)*/
 #define SHADOW_WIDTH    (LV_DPI / 8)
 #define IMG_RECOLOR     LV_OPA_20
 #define OPACITY         LV_OPA_60
+#define LAT_EVENT_PERIOD    97  /*Time between the virtual input events [ms]*/
+#define LAT_EVENT_JITTER    31  /*Add at most this much to the period to not be in sync. with the refreshes [ms]*/
+#define TRACE_MEM_PERIOD    16  /*Trace the memory usage after every this many refreshes (`lv_mem_monitor` walks the whole heap)*/
 
 /**********************
  *      TYPEDEFS
@@ -27,11 +30,54 @@
  *  STATIC PROTOTYPES
  **********************/
 static void refr_monitor(lv_disp_drv_t * disp_drv, uint32_t time_ms, uint32_t px_num);
+static void anim_monitor(lv_disp_drv_t * disp_drv, uint32_t time_ms, uint32_t px_num);
+static void refr_task_wrapper(lv_task_t * task);
+static void join_measure(lv_disp_t * disp);
+static void flush_wrapper(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p);
+static void flush_wrapper_remove(lv_disp_drv_t * disp_drv);
+static uint64_t clock_ns(void);
+static void mem_sample(void);
+static void trace(benchmark_trace_type_t type, uint64_t start, uint64_t end, uint32_t value, const char * name);
+static void trace_refr(uint64_t end, uint32_t px_num);
+static void trace_style(uint8_t old_style, const char * feature);
+static void sum_reset(void);
 static void run_test_event_cb(lv_obj_t * btn, lv_event_t event);
 static void wp_btn_event_cb(lv_obj_t * btn, lv_event_t event);
 static void recolor_btn_event_cb(lv_obj_t * btn, lv_event_t event);
 static void shadow_btn_event_cb(lv_obj_t * btn, lv_event_t event);
 static void opa_btn_event_cb(lv_obj_t * btn, lv_event_t event);
+static void run_matrix_event_cb(lv_obj_t * btn, lv_event_t event);
+static void wp_set(bool en);
+static void recolor_set(bool en);
+static void shadow_set(bool en);
+static void opa_set(bool en);
+static void tgl_btn_set(lv_obj_t * btn, bool en);
+static void matrix_show_result(void);
+static void run_scenes_event_cb(lv_obj_t * btn, lv_event_t event);
+static void run_anim_event_cb(lv_obj_t * btn, lv_event_t event);
+static void run_engine_event_cb(lv_obj_t * btn, lv_event_t event);
+static void run_text_event_cb(lv_obj_t * btn, lv_event_t event);
+static void run_img_event_cb(lv_obj_t * btn, lv_event_t event);
+static uint32_t scene_load(const benchmark_scene_t * scene);
+static void scene_show_result(void);
+static void test_show_result(void);
+static const char * matrix_name_get(uint16_t id);
+static void dirty_show_result(void);
+static void run_dirty_event_cb(lv_obj_t * btn, lv_event_t event);
+static void run_obj_event_cb(lv_obj_t * btn, lv_event_t event);
+static void obj_show_result(void);
+static void run_layout_event_cb(lv_obj_t * btn, lv_event_t event);
+static void layout_show_result(void);
+static void run_style_mod_event_cb(lv_obj_t * btn, lv_event_t event);
+static void style_mod_show_result(void);
+static void anim_result_calc(benchmark_anim_result_t * res, uint64_t end);
+static void anim_show_result(void);
+static void run_latency_event_cb(lv_obj_t * btn, lv_event_t event);
+static bool lat_read_cb(lv_indev_drv_t * indev_drv, lv_indev_data_t * data);
+static void lat_task_cb(lv_task_t * task);
+static void lat_monitor(lv_disp_drv_t * disp_drv, uint32_t time_ms, uint32_t px_num);
+static void lat_show_result(void);
+static void result_calc(benchmark_result_t * res, uint32_t * samples, uint16_t cnt, uint64_t px_total);
 
 /**********************
  *  STATIC VARIABLES
@@ -39,6 +85,10 @@ static void opa_btn_event_cb(lv_obj_t * btn, lv_event_t event);
 static lv_obj_t * holder_page;
 static lv_obj_t * wp;
 static lv_obj_t * result_label;
+static lv_obj_t * wp_btn;
+static lv_obj_t * recolor_btn;
+static lv_obj_t * shadow_btn;
+static lv_obj_t * opa_btn;
 
 static lv_style_t style_wp;
 static lv_style_t style_btn_rel;
@@ -46,8 +96,103 @@ static lv_style_t style_btn_pr;
 static lv_style_t style_btn_tgl_rel;
 static lv_style_t style_btn_tgl_pr;
 
-static uint32_t time_sum;
+static uint32_t sample_buf[BENCHMARK_SAMPLE_MAX];
+static uint16_t warmup_num = BENCHMARK_DEF_WARMUP_NUM;
+static uint16_t sample_num = BENCHMARK_DEF_SAMPLE_NUM;
 static uint32_t refr_cnt;
+static bool refr_done;              /*All the refreshes of the test are measured*/
+static uint64_t px_sum;
+static void (*orig_flush_cb)(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p);
+static benchmark_clock_cb_t clock_cb;
+static uint64_t refr_start;         /*Clock value at the start of the current refresh*/
+static benchmark_cnt_cb_t cnt_cb;
+static uint64_t cnt_start[BENCHMARK_CNT_NUM];   /*Counter values at the start of the current refresh*/
+static uint64_t cnt_sum[BENCHMARK_CNT_NUM];
+static benchmark_mem_cnt_cb_t mem_cnt_cb;
+static uint32_t alloc_start;        /*Allocation count at the start of the measured refreshes*/
+static uint32_t free_start;
+static benchmark_mem_peak_cb_t mem_peak_cb;
+static uint32_t mem_used_start;     /*`lv_mem` usage at the start of the test*/
+static uint32_t mem_alloc_start;    /*Allocated bytes reported by `mem_peak_cb` at the same time*/
+static uint32_t mem_peak;
+static uint8_t frag_max;
+static uint32_t first_time;         /*Time of the first refresh of the test*/
+static uint32_t flush_time;         /*Time spent in the display's `flush_cb` during the current refresh*/
+static uint32_t wait_time;          /*Time spent waiting for `lv_disp_flush_ready` during the current refresh*/
+static benchmark_trace_cb_t trace_cb;
+static uint32_t trace_refr_cnt;     /*Number of traced refreshes*/
+static uint64_t render_start;       /*Clock value where the current rendering started (after the previous flush)*/
+static uint32_t render_sum;
+static uint32_t flush_sum;
+static uint32_t wait_sum;
+static benchmark_result_t result;
+static benchmark_ready_cb_t ready_cb;
+
+static uint8_t style_act;
+static uint8_t style_saved;
+static bool matrix_run;
+static uint8_t matrix_act;
+static bool matrix_valid;
+static benchmark_result_t matrix_res[BENCHMARK_STYLE_NUM];
+
+static const benchmark_scene_t * scenes;
+static uint16_t scene_cnt;          /*Number of scenes to run*/
+static uint16_t scene_act;
+static uint16_t scene_done_cnt;     /*Number of measured scenes*/
+static bool scene_run;
+static lv_obj_t * scene_scr;
+static benchmark_result_t scene_res[BENCHMARK_SCENE_MAX];
+static uint32_t scene_px[BENCHMARK_SCENE_MAX];
+static uint32_t scene_chars[BENCHMARK_SCENE_MAX];   /*Number of characters told by the scenes*/
+static benchmark_text_result_t text_res[BENCHMARK_SCENE_MAX];
+
+static bool dirty_run;
+static bool dirty_valid;
+static bool inv_full = true;        /*Invalidate the whole screen after each refresh*/
+static uint32_t inv_area_cnt;       /*Number of invalidated areas at the start of the current refresh*/
+static uint64_t area_sum;
+static uint64_t join_time;          /*Time of merging the invalidated areas before the current refresh [ns]*/
+static uint32_t joined_cnt;         /*Number of areas left after merging them before the current refresh*/
+static uint64_t join_sum;
+static uint64_t joined_sum;
+static uint64_t update_sum;         /*Time spent in the scene's `update_cb`*/
+static benchmark_dirty_result_t dirty_res[BENCHMARK_SCENE_MAX];
+
+static const benchmark_scene_t * anims;
+static uint16_t anim_cnt;           /*Number of animated scenes to run*/
+static uint16_t anim_act;
+static uint16_t anim_done_cnt;      /*Number of measured animated scenes*/
+static bool anim_run;
+static uint32_t anim_time = BENCHMARK_DEF_ANIM_TIME;
+static benchmark_anim_result_t anim_res[BENCHMARK_SCENE_MAX];
+static uint64_t anim_begin;         /*Clock value at the start of the first measured refresh*/
+static uint64_t anim_last;          /*Clock value at the start of the previous refresh*/
+static uint64_t period_sum;         /*Sum of the times between the start of the refreshes*/
+static uint64_t period_sq_sum;
+static uint32_t period_max;
+static uint32_t dropped_cnt;
+static uint64_t refr_sum;
+static uint32_t refr_max;
+static uint16_t period_sample_cnt;  /*Number of periods in `sample_buf`*/
+static uint32_t period_sample_step; /*Keep every this many periods to cover the whole scene*/
+static uint32_t period_idx;         /*Index of the current period in the scene*/
+
+static lv_obj_t * lat_btn;           /*The button pressed by the virtual input device*/
+static lv_indev_t * lat_indev;
+static lv_task_t * lat_task;
+static bool lat_run;
+static bool lat_valid;
+static bool lat_load;               /*Redraw the whole screen on every refresh*/
+static bool lat_pressed;            /*State of the virtual input device*/
+static bool lat_pending;            /*An event is waiting for its response to be shown*/
+static bool lat_handled;            /*The button handled the pending event*/
+static uint64_t lat_event;          /*Clock value of the pending event*/
+static uint64_t lat_handle;         /*Clock value when the button handled the pending event*/
+static uint32_t lat_cnt;
+static uint32_t lat_rnd = 1;
+static uint64_t lat_input_sum;
+static uint64_t lat_refr_sum;
+static benchmark_latency_result_t lat_res[2];   /*Idle and load*/
 
 LV_IMG_DECLARE(benchmark_bg)
 
@@ -118,6 +263,9 @@ void benchmark_create(void)
     lv_label_set_body_draw(result_label, true);
     lv_label_set_style(result_label, LV_LABEL_STYLE_MAIN, &lv_style_pretty);
 
+    /*Create the histogram and the table below the label to show the details of the results*/
+    benchmark_result_view_create(holder_page);
+
     /*Create a "Run test" button*/
     lv_obj_t * btn;
     btn = lv_btn_create(holder_page, NULL);
@@ -134,33 +282,112 @@ void benchmark_create(void)
     lv_label_set_text(btn_l, "Run\ntest!");
     lv_obj_set_protect(btn, LV_PROTECT_FOLLOW);     /*Line break in layout*/
 
+    /*Create a "Run all style combinations" button*/
+    btn = lv_btn_create(holder_page, btn);
+    lv_obj_clear_protect(btn, LV_PROTECT_FOLLOW);
+    lv_obj_set_event_cb(btn, run_matrix_event_cb);
+    btn_l = lv_label_create(btn, btn_l);
+    lv_label_set_text(btn_l, "Run\nmatrix!");
+
+    /*Create a "Run the drawing primitive scenes" button*/
+    btn = lv_btn_create(holder_page, btn);
+    lv_obj_set_event_cb(btn, run_scenes_event_cb);
+    btn_l = lv_label_create(btn, btn_l);
+    lv_label_set_text(btn_l, "Run\nscenes!");
+
+    /*Create a "Run the animated scenes" button*/
+    btn = lv_btn_create(holder_page, btn);
+    lv_obj_set_event_cb(btn, run_anim_event_cb);
+    btn_l = lv_label_create(btn, btn_l);
+    lv_label_set_text(btn_l, "Run\nanim!");
+
+    /*Create a "Run the animation engine scenes" button*/
+    btn = lv_btn_create(holder_page, btn);
+    lv_obj_set_event_cb(btn, run_engine_event_cb);
+    btn_l = lv_label_create(btn, btn_l);
+    lv_label_set_text(btn_l, "Run\nanim. engine!");
+
+    /*Create a "Run the text scenes" button*/
+    btn = lv_btn_create(holder_page, btn);
+    lv_obj_set_event_cb(btn, run_text_event_cb);
+    btn_l = lv_label_create(btn, btn_l);
+    lv_label_set_text(btn_l, "Run\ntext!");
+
+    /*Create a "Run the image source scenes" button*/
+    btn = lv_btn_create(holder_page, btn);
+    lv_obj_set_event_cb(btn, run_img_event_cb);
+    btn_l = lv_label_create(btn, btn_l);
+    lv_label_set_text(btn_l, "Run\nimages!");
+
+    /*Create a "Run the small invalidations scenes" button*/
+    btn = lv_btn_create(holder_page, btn);
+    lv_obj_set_event_cb(btn, run_dirty_event_cb);
+    btn_l = lv_label_create(btn, btn_l);
+    lv_label_set_text(btn_l, "Run\ndirty!");
+
+    /*Create a "Run the object scaling test" button*/
+    btn = lv_btn_create(holder_page, btn);
+    lv_obj_set_event_cb(btn, run_obj_event_cb);
+    btn_l = lv_label_create(btn, btn_l);
+    lv_label_set_text(btn_l, "Run\nobjects!");
+
+    /*Create a "Run the layout test" button*/
+    btn = lv_btn_create(holder_page, btn);
+    lv_obj_set_event_cb(btn, run_layout_event_cb);
+    btn_l = lv_label_create(btn, btn_l);
+    lv_label_set_text(btn_l, "Run\nlayout!");
+
+    /*Create a "Run the shared style test" button*/
+    btn = lv_btn_create(holder_page, btn);
+    lv_obj_set_event_cb(btn, run_style_mod_event_cb);
+    btn_l = lv_label_create(btn, btn_l);
+    lv_label_set_text(btn_l, "Run\nstyles!");
+
+    /*Create a "Run the input latency test" button. The test presses this button too.*/
+    btn = lv_btn_create(holder_page, btn);
+    lv_obj_set_event_cb(btn, run_latency_event_cb);
+    btn_l = lv_label_create(btn, btn_l);
+    lv_label_set_text(btn_l, "Run\nlatency!");
+    lat_btn = btn;
 
     /*Create a "Wallpaper show" button*/
     btn = lv_btn_create(holder_page, btn);
     lv_btn_set_toggle(btn, true);
-    lv_obj_clear_protect(btn, LV_PROTECT_FOLLOW);
     lv_obj_set_event_cb(btn, wp_btn_event_cb);
     btn_l = lv_label_create(btn, btn_l);
     lv_label_set_text(btn_l, "Wallpaper");
-
+    wp_btn = btn;
 
     /*Create a "Wallpaper re-color" button*/
     btn = lv_btn_create(holder_page, btn);
     lv_obj_set_event_cb(btn, recolor_btn_event_cb);
     btn_l = lv_label_create(btn, btn_l);
     lv_label_set_text(btn_l, "Wp. recolor!");
+    recolor_btn = btn;
 
     /*Create a "Shadow draw" button*/
     btn = lv_btn_create(holder_page, btn);
     lv_obj_set_event_cb(btn, shadow_btn_event_cb);
     btn_l = lv_label_create(btn, btn_l);
     lv_label_set_text(btn_l, "Shadow");
+    shadow_btn = btn;
 
     /*Create an "Opacity enable" button*/
     btn = lv_btn_create(holder_page, btn);
     lv_obj_set_event_cb(btn, opa_btn_event_cb);
     btn_l = lv_label_create(btn, btn_l);
     lv_label_set_text(btn_l, "Opacity");
+    opa_btn = btn;
+
+    style_act = 0;
+    matrix_run = false;
+    matrix_valid = false;
+    scene_run = false;
+    scene_done_cnt = 0;
+    anim_run = false;
+    anim_done_cnt = 0;
+    lat_run = false;
+    lat_valid = false;
 }
 
 
@@ -170,150 +397,1891 @@ void benchmark_start(void)
 
     disp->driver.monitor_cb = refr_monitor;
 
+    /*Wrap the display's flush to see how long it takes*/
+    if(disp->driver.flush_cb != flush_wrapper) {
+        orig_flush_cb = disp->driver.flush_cb;
+        disp->driver.flush_cb = flush_wrapper;
+    }
+
+    /*Wrap the refresh task to read the clock when a refresh starts*/
+    disp->refr_task->task_cb = refr_task_wrapper;
+
+    /*Don't measure the previous result*/
+    benchmark_result_view_hide();
+
     lv_obj_invalidate(lv_disp_get_scr_act(disp));
 
-    time_sum = 0;
-    refr_cnt = 0;
+    sum_reset();
+    refr_done = false;
+    flush_time = 0;
+    wait_time = 0;
 }
 
 bool benchmark_is_ready(void)
 {
-    if(refr_cnt == TEST_CYCLE_NUM) return true;
-    else return false;
+    if(matrix_run || scene_run || anim_run || lat_run) return false;
+
+    return refr_done;
 }
 
 uint32_t benchmark_get_refr_time(void)
 {
-    if(benchmark_is_ready()) return time_sum / TEST_CYCLE_NUM;
+    if(benchmark_is_ready()) return result.avg;
     else return 0;
 }
 
-/*--------------------
- * OTHER FUNCTIONS
- ---------------------*/
+/**
+ * Set how many refreshes to measure. Applies from the next `benchmark_start()`.
+ * @param warmup number of refreshes to drop at the beginning (e.g. to fill the caches)
+ * @param sample number of refreshes to measure. Limited to `BENCHMARK_SAMPLE_MAX`.
+ */
+void benchmark_set_sample_num(uint16_t warmup, uint16_t sample)
+{
+    if(sample == 0) sample = 1;
+    if(sample > BENCHMARK_SAMPLE_MAX) sample = BENCHMARK_SAMPLE_MAX;
+
+    warmup_num = warmup;
+    sample_num = sample;
+}
 
 /**
- * Called when a the library finished rendering to monitor its performance
- * @param disp_drv pointer to the caller display driver
- * @param time_ms time of rendering in milliseconds
- * @param px_num Number of pixels drawn
+ * Set a function to call when a test (or the whole matrix) is finished.
+ * This way `benchmark_is_ready()` doesn't need to be polled.
+ * @param cb the callback or NULL to not use it
  */
-static void refr_monitor(lv_disp_drv_t * disp_drv, uint32_t time_ms, uint32_t px_num)
+void benchmark_set_ready_cb(benchmark_ready_cb_t cb)
 {
-    (void) px_num   ; /*Unused*/
-    lv_disp_t * disp = lv_obj_get_disp(holder_page);
-    time_sum += time_ms;
-    refr_cnt ++;
-    lv_obj_invalidate(lv_disp_get_scr_act(disp));
+    ready_cb = cb;
+}
 
-    if(refr_cnt >= TEST_CYCLE_NUM) {
-        int time_avg = (int)time_sum / (int)TEST_CYCLE_NUM;
-        char buf[256];
-        sprintf(buf, "Screen load: %d ms\nAverage of %d", time_avg, TEST_CYCLE_NUM);
-        lv_label_set_text(result_label, buf);
-        disp_drv->monitor_cb = NULL;
-    } else {
-        char buf[256];
-        sprintf(buf, "Running %d/%d", refr_cnt, TEST_CYCLE_NUM);
-        lv_label_set_text(result_label, buf);
+/**
+ * Set a high resolution clock to measure the refreshes with.
+ * Without it `lv_tick_get()` is used which has only millisecond resolution.
+ * @param cb a function returning a monotonic time in nanoseconds or NULL to use `lv_tick_get()`
+ */
+void benchmark_set_clock_cb(benchmark_clock_cb_t cb)
+{
+    clock_cb = cb;
+}
+
+/**
+ * Set a function to read hardware counters (e.g. instructions, cache misses) with.
+ * They are read before and after each refresh and their average change per refresh
+ * is stored in `benchmark_result_t.cnt_avg`.
+ * @param cb a function writing the `BENCHMARK_CNT_NUM` counter values to its parameter
+ *           or NULL to not read counters
+ */
+void benchmark_set_cnt_cb(benchmark_cnt_cb_t cb)
+{
+    cnt_cb = cb;
+}
+
+/**
+ * Set a function to count the `lv_mem` allocations and frees with (e.g. by wrapping `lv_mem_alloc`).
+ * They are read before and after the measured refreshes and their change
+ * is stored in `benchmark_result_t.alloc_cnt/free_cnt`.
+ * @param cb a function writing the allocation and free counts to its parameters or NULL to not count them
+ */
+void benchmark_set_mem_cnt_cb(benchmark_mem_cnt_cb_t cb)
+{
+    mem_cnt_cb = cb;
+}
+
+/**
+ * Set a function to follow the peak `lv_mem` usage with (e.g. by wrapping `lv_mem_alloc`).
+ * Without it the usage is sampled only between the refreshes so the memory allocated and freed
+ * while drawing (e.g. by an image decoder) is not seen in `benchmark_result_t.mem_peak`.
+ * @param cb a function returning the peak allocated bytes or NULL to sample between the refreshes only
+ */
+void benchmark_set_mem_peak_cb(benchmark_mem_peak_cb_t cb)
+{
+    mem_peak_cb = cb;
+}
+
+/**
+ * Set a function to receive the timeline of the tests: the refreshes with their rendering and flushing,
+ * the scenes' updates, the memory usage and the changes of the style features and scenes.
+ * E.g. to write them as a trace to see the stalls of a test.
+ * @param cb a function storing the events or NULL to not trace
+ */
+void benchmark_set_trace_cb(benchmark_trace_cb_t cb)
+{
+    trace_cb = cb;
+}
+
+/**
+ * Read the clock set by `benchmark_set_clock_cb()`
+ * @return the current time in nanoseconds
+ */
+uint64_t benchmark_get_time_ns(void)
+{
+    return clock_ns();
+}
+
+/**
+ * Integer square root for the standard deviations of the tests
+ * @param x a number
+ * @return the floor of the square root of `x`
+ */
+uint32_t benchmark_sqrt_u64(uint64_t x)
+{
+    uint64_t r = 0;
+    uint64_t bit = (uint64_t)1 << 62;
+
+    while(bit > x) bit >>= 2;
 
+    while(bit != 0) {
+        if(x >= r + bit) {
+            x -= r + bit;
+            r = (r >> 1) + bit;
+        } else {
+            r >>= 1;
+        }
+        bit >>= 2;
     }
+
+    return (uint32_t)r;
 }
 
 /**
- * Called when the "Run test" button is clicked
- * @param btn pointer to the button
- * @param event the current event
+ * Tell whether some more memory can be allocated.
+ * LittlevGL can't recover from running out of memory so it's better to not try.
+ * @param need the memory to allocate in bytes (25% is added for the fragmentation) or 0 to check only `BENCHMARK_MEM_RESERVE`
+ * @return true: probably enough (or can't be decided); false: surely not enough
  */
-static void run_test_event_cb(lv_obj_t * btn, lv_event_t event)
+bool benchmark_mem_is_enough(uint64_t need)
 {
-    (void) btn; /*Unused*/
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
 
-    if(event != LV_EVENT_CLICKED) return;
+    /*With `LV_MEM_CUSTOM` the monitor can't tell anything*/
+    if(mon.total_size == 0) return true;
 
-    benchmark_start();
+    if(need * 5 / 4 + BENCHMARK_MEM_RESERVE > mon.free_biggest_size) return false;
+    else return true;
 }
 
 /**
- * Called when the "Wallpaper" button is clicked
- * @param btn pointer to the button
- * @param event the current event
+ * Get the statistics of the last test
+ * @return pointer to the result or NULL if the test is not ready
  */
-static void wp_btn_event_cb(lv_obj_t * btn, lv_event_t event)
+const benchmark_result_t * benchmark_get_result(void)
 {
-    if(event != LV_EVENT_CLICKED) return;
+    if(benchmark_is_ready()) return &result;
+    else return NULL;
+}
+
+/**
+ * Enable or disable the style features (wallpaper, recolor, shadow, opacity) at once.
+ * The toggle buttons are updated too.
+ * @param style OR-ed values of `BENCHMARK_STYLE_...`
+ */
+void benchmark_set_style(uint8_t style)
+{
+    wp_set(style & BENCHMARK_STYLE_WP ? true : false);
+    recolor_set(style & BENCHMARK_STYLE_RECOLOR ? true : false);
+    shadow_set(style & BENCHMARK_STYLE_SHADOW ? true : false);
+    opa_set(style & BENCHMARK_STYLE_OPA ? true : false);
 
-    if(lv_btn_get_state(btn) == LV_BTN_STATE_TGL_REL) lv_obj_set_hidden(wp, false);
-    else lv_obj_set_hidden(wp, true);
+    tgl_btn_set(wp_btn, style & BENCHMARK_STYLE_WP ? true : false);
+    tgl_btn_set(recolor_btn, style & BENCHMARK_STYLE_RECOLOR ? true : false);
+    tgl_btn_set(shadow_btn, style & BENCHMARK_STYLE_SHADOW ? true : false);
+    tgl_btn_set(opa_btn, style & BENCHMARK_STYLE_OPA ? true : false);
 }
 
 /**
- * Called when the "Wp. recolor" button is clicked
- * @param btn pointer to the button
- * @param event the current event
+ * Get the currently enabled style features
+ * @return OR-ed values of `BENCHMARK_STYLE_...`
  */
-static void recolor_btn_event_cb(lv_obj_t * btn, lv_event_t event)
+uint8_t benchmark_get_style(void)
 {
-    if(event != LV_EVENT_CLICKED) return;
+    return style_act;
+}
 
-    if(lv_btn_get_state(btn) == LV_BTN_STATE_TGL_REL) style_wp.image.intense = IMG_RECOLOR;
-    else style_wp.image.intense = LV_OPA_TRANSP;
+/**
+ * Get the name of a style combination, e.g. "wp+shadow"
+ * @param style OR-ed values of `BENCHMARK_STYLE_...`
+ * @return the name in a static buffer
+ */
+const char * benchmark_get_style_name(uint8_t style)
+{
+    static char buf[32];
 
-    lv_obj_refresh_style(wp);
+    if(style == 0) return "none";
+
+    buf[0] = '\0';
+    if(style & BENCHMARK_STYLE_WP) strcat(buf, "+wp");
+    if(style & BENCHMARK_STYLE_RECOLOR) strcat(buf, "+recolor");
+    if(style & BENCHMARK_STYLE_SHADOW) strcat(buf, "+shadow");
+    if(style & BENCHMARK_STYLE_OPA) strcat(buf, "+opa");
+
+    return &buf[1];     /*Skip the first '+'*/
 }
 
 /**
- * Called when the "Shadow" button is clicked
- * @param btn pointer to the button
- * @param event the current event
+ * Run the test with all the `BENCHMARK_STYLE_NUM` combinations of the style features one after the other.
+ * `benchmark_is_ready()` returns `true` when all of them are finished.
+ * The original style is restored at the end.
  */
-static void shadow_btn_event_cb(lv_obj_t * btn, lv_event_t event)
+void benchmark_start_matrix(void)
 {
-    if(event != LV_EVENT_CLICKED) return;
+    style_saved = style_act;
+    matrix_act = 0;
+    matrix_run = true;
+    matrix_valid = false;
 
-    if(lv_btn_get_state(btn) == LV_BTN_STATE_TGL_REL) {
-        style_btn_rel.body.shadow.width = SHADOW_WIDTH;
-        style_btn_pr.body.shadow.width  =  SHADOW_WIDTH;
-        style_btn_tgl_rel.body.shadow.width = SHADOW_WIDTH;
-        style_btn_tgl_pr.body.shadow.width =  SHADOW_WIDTH;
-    } else {
-        style_btn_rel.body.shadow.width = 0;
-        style_btn_pr.body.shadow.width  = 0;
-        style_btn_tgl_rel.body.shadow.width = 0;
-        style_btn_tgl_pr.body.shadow.width = 0;
-    }
+    benchmark_set_style(matrix_act);
+    benchmark_start();
+}
 
-    lv_obj_report_style_mod(&style_btn_rel);
-    lv_obj_report_style_mod(&style_btn_pr);
-    lv_obj_report_style_mod(&style_btn_tgl_rel);
-    lv_obj_report_style_mod(&style_btn_tgl_pr);
+/**
+ * Tell whether all the style combinations are measured by `benchmark_start_matrix()`
+ * @return true: the matrix results are available
+ */
+bool benchmark_matrix_is_valid(void)
+{
+    return matrix_valid;
 }
 
 /**
- * Called when the "Opacity" button is clicked
- * @param btn pointer to the button
- * @param event the current event
+ * Get the average refresh time of a style combination measured by `benchmark_start_matrix()`
+ * @param style OR-ed values of `BENCHMARK_STYLE_...`
+ * @return the refresh time in microseconds or 0 if the matrix is not measured yet
  */
-static void opa_btn_event_cb(lv_obj_t * btn, lv_event_t event)
+uint32_t benchmark_get_matrix_time(uint8_t style)
 {
-    if(event != LV_EVENT_CLICKED) return;
+    if(matrix_valid == false || style >= BENCHMARK_STYLE_NUM) return 0;
 
-    if(lv_btn_get_state(btn) == LV_BTN_STATE_TGL_REL) {
-        style_btn_rel.body.opa = OPACITY;
-        style_btn_pr.body.opa  = OPACITY;
-        style_btn_tgl_rel.body.opa = OPACITY;
-        style_btn_tgl_pr.body.opa = OPACITY;
-    } else {
-        style_btn_rel.body.opa = LV_OPA_COVER;
-        style_btn_pr.body.opa  = LV_OPA_COVER;
-        style_btn_tgl_rel.body.opa = LV_OPA_COVER;
-        style_btn_tgl_pr.body.opa = LV_OPA_COVER;
+    return matrix_res[style].avg;
+}
+
+/**
+ * Get the statistics of a style combination measured by `benchmark_start_matrix()`
+ * @param style OR-ed values of `BENCHMARK_STYLE_...`
+ * @return pointer to the result or NULL if the matrix is not measured yet
+ */
+const benchmark_result_t * benchmark_get_matrix_result(uint8_t style)
+{
+    if(matrix_valid == false || style >= BENCHMARK_STYLE_NUM) return NULL;
+
+    return &matrix_res[style];
+}
+
+/**
+ * Get how much a style feature adds to the refresh time.
+ * It's the average difference between the combinations with and without the feature
+ * so the interaction with the other features is also considered.
+ * @param feature a `BENCHMARK_STYLE_...` value
+ * @return the extra time in microseconds (can be negative) or 0 if the matrix is not measured yet
+ */
+int32_t benchmark_get_feature_cost(uint8_t feature)
+{
+    if(matrix_valid == false) return 0;
+
+    int32_t sum = 0;
+    uint8_t s;
+    for(s = 0; s < BENCHMARK_STYLE_NUM; s++) {
+        if(s & feature) continue;
+        sum += (int32_t)matrix_res[s | feature].avg - (int32_t)matrix_res[s].avg;
     }
 
-    lv_obj_report_style_mod(&style_btn_rel);
-    lv_obj_report_style_mod(&style_btn_pr);
-    lv_obj_report_style_mod(&style_btn_tgl_rel);
-    lv_obj_report_style_mod(&style_btn_tgl_pr);
+    return sum / (BENCHMARK_STYLE_NUM / 2);
+}
+
+/**
+ * Measure scenes one after the other. Each scene is created on a new screen
+ * which is deleted when its test is finished.
+ * `benchmark_is_ready()` returns `true` when all of them are finished.
+ * @param scene_array the scenes to run. The first should be an empty scene
+ *                    as the costs are calculated relative to it.
+ *                    Only the pointer is saved so it should be static.
+ * @param cnt number of scenes in `scene_array`. Limited to `BENCHMARK_SCENE_MAX`.
+ */
+void benchmark_start_scenes(const benchmark_scene_t * scene_array, uint16_t cnt)
+{
+    if(cnt == 0) return;
+    if(cnt > BENCHMARK_SCENE_MAX) cnt = BENCHMARK_SCENE_MAX;
+
+    scenes = scene_array;
+    scene_cnt = cnt;
+    scene_act = 0;
+    scene_done_cnt = 0;
+    scene_run = true;
+    dirty_run = false;
+    dirty_valid = false;
+    inv_full = true;
+    memset(scene_chars, 0, sizeof(scene_chars));
+
+    scene_px[scene_act] = scene_load(&scenes[scene_act]);
+    benchmark_start();
+}
+
+/**
+ * Get the number of scenes measured by `benchmark_start_scenes()`
+ * @return number of scenes or 0 if not ready yet
+ */
+uint16_t benchmark_get_scene_cnt(void)
+{
+    if(scene_run) return 0;
+
+    return scene_done_cnt;
+}
+
+/**
+ * Get the name of a measured scene
+ * @param id index of the scene
+ * @return name of the scene or NULL if `id` is invalid
+ */
+const char * benchmark_get_scene_name(uint16_t id)
+{
+    if(id >= benchmark_get_scene_cnt()) return NULL;
+
+    return scenes[id].name;
+}
+
+/**
+ * Get the statistics of a measured scene
+ * @param id index of the scene
+ * @return pointer to the result or NULL if `id` is invalid
+ */
+const benchmark_result_t * benchmark_get_scene_result(uint16_t id)
+{
+    if(id >= benchmark_get_scene_cnt()) return NULL;
+
+    return &scene_res[id];
+}
+
+/**
+ * Get the cost of drawing 1000 pixels in a scene.
+ * The time of the first (empty) scene is subtracted.
+ * @param id index of the scene
+ * @return nanoseconds per 1000 pixels or 0 if the scene doesn't tell its pixel count
+ */
+uint32_t benchmark_get_scene_cost(uint16_t id)
+{
+    if(id >= benchmark_get_scene_cnt() || scene_px[id] == 0) return 0;
+
+    const benchmark_result_t * base = &scene_res[0];
+    const benchmark_result_t * res = &scene_res[id];
+
+    int64_t diff_ns = ((int64_t)res->sum * 1000) / res->sample_cnt - ((int64_t)base->sum * 1000) / base->sample_cnt;
+    if(diff_ns <= 0) return 0;
+
+    return (uint32_t)(((uint64_t)diff_ns * 1000) / scene_px[id]);
+}
+
+/**
+ * Tell the number of characters in the current scene. Call it from the scene's `create_cb` or `update_cb`.
+ * Scenes which call it get a `benchmark_text_result_t` too.
+ * @param cnt number of characters (not bytes) on the screen
+ */
+void benchmark_set_scene_char_cnt(uint32_t cnt)
+{
+    if(scene_run == false) return;
+
+    scene_chars[scene_act] = cnt;
+}
+
+/**
+ * Get the text throughput of a scene measured by `benchmark_start_scenes()`
+ * @param id index of the scene
+ * @return pointer to the result or NULL if `id` is invalid or the scene didn't tell its number of characters
+ */
+const benchmark_text_result_t * benchmark_get_text_result(uint16_t id)
+{
+    if(id >= benchmark_get_scene_cnt() || text_res[id].char_cnt == 0) return NULL;
+
+    return &text_res[id];
+}
+
+/**
+ * Measure scenes which change small parts of the screen before every refresh (`update_cb` of the scenes).
+ * Each scene is measured twice: first only the changed areas are redrawn,
+ * then the whole screen is invalidated too as in the other tests.
+ * `benchmark_get_scene_...()` return the first, `benchmark_get_dirty_result()` compares the two.
+ * `benchmark_is_ready()` returns `true` when all of them are finished.
+ * @param scene_array the scenes to run. Only the pointer is saved so it should be static.
+ * @param cnt number of scenes in `scene_array`. Limited to `BENCHMARK_SCENE_MAX`.
+ */
+void benchmark_start_dirty(const benchmark_scene_t * scene_array, uint16_t cnt)
+{
+    if(cnt == 0) return;
+
+    benchmark_start_scenes(scene_array, cnt);
+
+    /*Let only the scene invalidate what it changes*/
+    dirty_run = true;
+    inv_full = false;
+}
+
+/**
+ * Get the comparison of partial and full screen redraw of a scene measured by `benchmark_start_dirty()`
+ * @param id index of the scene
+ * @return pointer to the result or NULL if `id` is invalid or the last scenes were not started by `benchmark_start_dirty()`
+ */
+const benchmark_dirty_result_t * benchmark_get_dirty_result(uint16_t id)
+{
+    if(dirty_valid == false || id >= benchmark_get_scene_cnt()) return NULL;
+
+    return &dirty_res[id];
+}
+
+/**
+ * Set how long to measure each animated scene. Applies from the next `benchmark_start_anim()`.
+ * @param time_ms measure time in milliseconds
+ */
+void benchmark_set_anim_time(uint32_t time_ms)
+{
+    if(time_ms == 0) time_ms = 1;
+
+    anim_time = time_ms;
+}
+
+/**
+ * Measure scenes with continuous animations one after the other.
+ * Unlike the other tests the screen is not invalidated, only the animations redraw what they change.
+ * Each scene is measured for the time set by `benchmark_set_anim_time()`.
+ * `benchmark_is_ready()` returns `true` when all of them are finished.
+ * @param scene_array the scenes to run. Only the pointer is saved so it should be static.
+ * @param cnt number of scenes in `scene_array`. Limited to `BENCHMARK_SCENE_MAX`.
+ */
+void benchmark_start_anim(const benchmark_scene_t * scene_array, uint16_t cnt)
+{
+    if(cnt == 0) return;
+    if(cnt > BENCHMARK_SCENE_MAX) cnt = BENCHMARK_SCENE_MAX;
+
+    anims = scene_array;
+    anim_cnt = cnt;
+    anim_act = 0;
+    anim_done_cnt = 0;
+    anim_run = true;
+
+    scene_load(&anims[anim_act]);
+    benchmark_start();
+
+    lv_disp_t * disp = lv_obj_get_disp(holder_page);
+    disp->driver.monitor_cb = anim_monitor;
+}
+
+/**
+ * Get the number of scenes measured by `benchmark_start_anim()`
+ * @return number of scenes or 0 if not ready yet
+ */
+uint16_t benchmark_get_anim_cnt(void)
+{
+    if(anim_run) return 0;
+
+    return anim_done_cnt;
+}
+
+/**
+ * Get the name of a measured animated scene
+ * @param id index of the scene
+ * @return name of the scene or NULL if `id` is invalid
+ */
+const char * benchmark_get_anim_name(uint16_t id)
+{
+    if(id >= benchmark_get_anim_cnt()) return NULL;
+
+    return anims[id].name;
+}
+
+/**
+ * Get the statistics of a measured animated scene
+ * @param id index of the scene
+ * @return pointer to the result or NULL if `id` is invalid
+ */
+const benchmark_anim_result_t * benchmark_get_anim_result(uint16_t id)
+{
+    if(id >= benchmark_get_anim_cnt()) return NULL;
+
+    return &anim_res[id];
+}
+
+/**
+ * Measure the time from a touch until the display shows the response (touch-to-photon latency).
+ * A virtual pointer input device presses and releases the "Run latency" button of the benchmark
+ * in slightly varying periods (to not follow the refresh and the input read periods in lockstep).
+ * The latency is the time from changing the state of the virtual device to the end of the flush after the
+ * button changed its style. It's measured first with the screen idle and then with the whole screen redrawn on every refresh (load).
+ * Both use the warm-up and sample numbers of `benchmark_set_sample_num()` as number of events.
+ * `benchmark_is_ready()` returns `true` when both are finished.
+ */
+void benchmark_start_latency(void)
+{
+    lv_disp_t * disp = lv_obj_get_disp(holder_page);
+
+    /*The device is created once and enabled only during the test*/
+    if(lat_indev == NULL) {
+        lv_indev_drv_t indev_drv;
+        lv_indev_drv_init(&indev_drv);
+        indev_drv.type = LV_INDEV_TYPE_POINTER;
+        indev_drv.read_cb = lat_read_cb;
+        indev_drv.disp = disp;
+        lat_indev = lv_indev_drv_register(&indev_drv);
+        if(lat_indev == NULL) return;
+    }
+    lat_indev->driver.disp = disp;
+    lv_indev_enable(lat_indev, true);
+
+    /*The button should be visible to be pressed*/
+    lv_page_focus(holder_page, lat_btn, LV_ANIM_OFF);
+
+    benchmark_start();
+    disp->driver.monitor_cb = lat_monitor;
+
+    lat_run = true;
+    lat_valid = false;
+    lat_load = false;
+    lat_pressed = false;
+    lat_pending = false;
+    lat_handled = false;
+    lat_cnt = 0;
+    lat_input_sum = 0;
+    lat_refr_sum = 0;
+    lat_task = lv_task_create(lat_task_cb, LAT_EVENT_PERIOD, LV_TASK_PRIO_MID, NULL);
+}
+
+/**
+ * Get the result of `benchmark_start_latency()`
+ * @param load false: the result with the screen idle; true: the result with the whole screen redrawn on every refresh
+ * @return pointer to the result or NULL if the latency is not measured yet
+ */
+const benchmark_latency_result_t * benchmark_get_latency_result(bool load)
+{
+    if(lat_valid == false) return NULL;
+
+    return &lat_res[load ? 1 : 0];
+}
+
+/*--------------------
+ * OTHER FUNCTIONS
+ ---------------------*/
+
+/**
+ * Called when a the library finished rendering to monitor its performance
+ * @param disp_drv pointer to the caller display driver
+ * @param time_ms time of rendering in milliseconds (not used, the benchmark's own clock is more precise)
+ * @param px_num Number of pixels drawn
+ */
+static void refr_monitor(lv_disp_drv_t * disp_drv, uint32_t time_ms, uint32_t px_num)
+{
+    (void) time_ms; /*Unused*/
+
+    uint64_t refr_end = clock_ns();
+    uint32_t time_us = (uint32_t)((refr_end - refr_start) / 1000);
+
+    /*Read the counters after the clock to not measure the reading*/
+    uint64_t cnt_end[BENCHMARK_CNT_NUM];
+    if(cnt_cb) cnt_cb(cnt_end);
+
+    if(trace_cb) trace_refr(refr_end, px_num);
+
+    lv_disp_t * disp = lv_obj_get_disp(holder_page);
+    refr_cnt ++;
+    if(refr_cnt == 1) first_time = time_us;
+    if(refr_cnt > warmup_num) {
+        sample_buf[refr_cnt - warmup_num - 1] = time_us;
+        px_sum += px_num;
+
+        /*Everything which is not flushing or waiting for the flush is rendering*/
+        uint32_t render_time = time_us > flush_time + wait_time ? time_us - flush_time - wait_time : 0;
+        render_sum += render_time;
+        flush_sum += flush_time;
+        wait_sum += wait_time;
+        area_sum += inv_area_cnt;
+        join_sum += join_time;
+        joined_sum += joined_cnt;
+
+        if(cnt_cb) {
+            uint8_t c;
+            for(c = 0; c < BENCHMARK_CNT_NUM; c++) cnt_sum[c] += cnt_end[c] - cnt_start[c];
+        }
+
+        mem_sample();
+    }
+    flush_time = 0;
+    wait_time = 0;
+
+    /*Count the allocations from the update before the first measured refresh
+     *to the end of the last measured refresh*/
+    uint32_t alloc_end = 0;
+    uint32_t free_end = 0;
+    if(mem_cnt_cb) {
+        if(refr_cnt == warmup_num) mem_cnt_cb(&alloc_start, &free_start);
+        else if(refr_cnt == (uint32_t)warmup_num + sample_num) mem_cnt_cb(&alloc_end, &free_end);
+    }
+
+    /*Add the peak inside the refreshes to the usage at the start of the test (see `sum_reset()`).
+     *The allocated bytes don't contain the block headers so it's a bit less than the real peak.*/
+    if(mem_peak_cb && refr_cnt == (uint32_t)warmup_num + sample_num) {
+        uint32_t used = mem_used_start + mem_peak_cb(false) - mem_alloc_start;
+        if(used > mem_peak) mem_peak = used;
+    }
+
+    /*Prepare the next refresh*/
+    if(scene_run && scenes[scene_act].update_cb) {
+        uint64_t t_update = clock_ns();
+        scenes[scene_act].update_cb(refr_cnt);
+        uint64_t t_update_end = clock_ns();
+        trace(BENCHMARK_TRACE_UPDATE, t_update, t_update_end, 0, NULL);
+        /*Count the updates before the measured refreshes*/
+        if(refr_cnt >= warmup_num && refr_cnt < (uint32_t)warmup_num + sample_num) {
+            update_sum += t_update_end - t_update;
+            mem_sample();
+        }
+    }
+
+    if(inv_full) lv_obj_invalidate(lv_disp_get_scr_act(disp));
+
+    if(refr_cnt < (uint32_t)warmup_num + sample_num) {
+        char buf[256];
+        if(refr_cnt <= warmup_num) sprintf(buf, "Warm-up %d/%d", refr_cnt, warmup_num);
+        else sprintf(buf, "Running %d/%d", refr_cnt - warmup_num, sample_num);
+        lv_label_set_text(result_label, buf);
+        return;
+    }
+
+    refr_done = true;
+    result_calc(&result, sample_buf, sample_num, px_sum);
+    result.first = first_time;
+    result.render_avg = render_sum / sample_num;
+    result.flush_avg = flush_sum / sample_num;
+    result.wait_avg = wait_sum / sample_num;
+    result.update_avg = (uint32_t)(update_sum / 1000 / sample_num);
+    result.mem_peak = mem_peak;
+    result.frag_pct = frag_max;
+    result.alloc_cnt = alloc_end - alloc_start;
+    result.free_cnt = free_end - free_start;
+
+    uint8_t c;
+    for(c = 0; c < BENCHMARK_CNT_NUM; c++) result.cnt_avg[c] = cnt_sum[c] / sample_num;
+
+    if(scene_run) {
+        if(dirty_run) {
+            benchmark_dirty_result_t * dres = &dirty_res[scene_act];
+            if(inv_full == false) {
+                /*Measure the same scene with full screen redraw too*/
+                scene_res[scene_act] = result;
+                benchmark_result_hist_save(scene_act, sample_buf, sample_num, &result);
+                dres->area_avg = (uint32_t)(area_sum / sample_num);
+                dres->update_avg = result.update_avg;
+                dres->partial_avg = result.avg;
+                dres->ns_per_area = dres->area_avg ? (uint32_t)((uint64_t)result.sum * 1000 / area_sum) : 0;
+                dres->join_ns = (uint32_t)(join_sum / sample_num);
+                dres->joined_avg = (uint32_t)(joined_sum / sample_num);
+                inv_full = true;
+                /*Else the first refresh of the full pass would be a partial one*/
+                lv_obj_invalidate(lv_disp_get_scr_act(disp));
+                sum_reset();
+                return;
+            }
+
+            dres->full_avg = result.avg;
+            inv_full = false;
+        } else {
+            scene_res[scene_act] = result;
+            benchmark_result_hist_save(scene_act, sample_buf, sample_num, &result);
+        }
+
+        /*The render time is spent mostly on the glyphs if the scene has text only*/
+        benchmark_text_result_t * tres = &text_res[scene_act];
+        tres->char_cnt = scene_chars[scene_act];
+        if(tres->char_cnt) {
+            tres->kchar_per_sec = result.render_avg ? (uint32_t)((uint64_t)tres->char_cnt * 1000 / result.render_avg) : 0;
+            tres->ns_per_char = (uint32_t)(update_sum / sample_num / tres->char_cnt);
+        }
+
+        scene_act++;
+        if(scene_act < scene_cnt) {
+            /*Measure the next scene*/
+            scene_px[scene_act] = scene_load(&scenes[scene_act]);
+            sum_reset();
+            return;
+        }
+
+        scene_run = false;
+        scene_done_cnt = scene_cnt;
+        disp_drv->monitor_cb = NULL;
+        flush_wrapper_remove(disp_drv);
+
+        if(dirty_run) {
+            dirty_run = false;
+            dirty_valid = true;
+            inv_full = true;
+        }
+
+        /*Go back to the benchmark's screen*/
+        lv_disp_load_scr(lv_obj_get_screen(holder_page));
+        lv_obj_del(scene_scr);
+        scene_scr = NULL;
+        if(dirty_valid) dirty_show_result();
+        else scene_show_result();
+    } else if(matrix_run) {
+        matrix_res[matrix_act] = result;
+        benchmark_result_hist_save(matrix_act, sample_buf, sample_num, &result);
+        matrix_act++;
+        if(matrix_act < BENCHMARK_STYLE_NUM) {
+            /*Measure the next combination*/
+            benchmark_set_style(matrix_act);
+            sum_reset();
+
+            char buf[256];
+            sprintf(buf, "Matrix %d/%d", matrix_act + 1, BENCHMARK_STYLE_NUM);
+            lv_label_set_text(result_label, buf);
+            return;
+        }
+
+        matrix_run = false;
+        matrix_valid = true;
+        disp_drv->monitor_cb = NULL;
+        flush_wrapper_remove(disp_drv);
+        benchmark_set_style(style_saved);
+        matrix_show_result();
+    } else {
+        disp_drv->monitor_cb = NULL;
+        flush_wrapper_remove(disp_drv);
+        test_show_result();
+    }
+
+    if(ready_cb) ready_cb();
+}
+
+/**
+ * Called after the refreshes of the animated scenes.
+ * Measures the time between the refreshes instead of invalidating the screen.
+ * @param disp_drv pointer to the caller display driver
+ * @param time_ms time of rendering in milliseconds (not used, the benchmark's own clock is more precise)
+ * @param px_num Number of pixels drawn
+ */
+static void anim_monitor(lv_disp_drv_t * disp_drv, uint32_t time_ms, uint32_t px_num)
+{
+    (void) time_ms; /*Unused*/
+
+    uint64_t now = clock_ns();
+    uint32_t time_us = (uint32_t)((now - refr_start) / 1000);
+    flush_time = 0;
+    wait_time = 0;
+
+    if(trace_cb) trace_refr(now, px_num);
+
+    refr_cnt++;
+    if(refr_cnt <= warmup_num) return;
+
+    if(refr_cnt == (uint32_t)warmup_num + 1) {
+        /*The periods are measured from the first measured refresh*/
+        anim_begin = refr_start;
+    } else {
+        uint32_t period = (uint32_t)((refr_start - anim_last) / 1000);
+        period_sum += period;
+        period_sq_sum += (uint64_t)period * period;
+        if(period > period_max) period_max = period;
+
+        /*Keep the periods for the histogram. If they don't fit drop every second and keep less from now on.*/
+        if(period_idx % period_sample_step == 0) {
+            if(period_sample_cnt == sample_num) {
+                uint16_t i;
+                for(i = 0; i < sample_num / 2; i++) sample_buf[i] = sample_buf[i * 2];
+                period_sample_cnt = sample_num / 2;
+                period_sample_step *= 2;
+            }
+            if(period_idx % period_sample_step == 0) {
+                sample_buf[period_sample_cnt] = period;
+                period_sample_cnt++;
+            }
+        }
+        period_idx++;
+
+        /*A period much longer than the display's refresh period means missed frames*/
+        lv_disp_t * disp = lv_obj_get_disp(holder_page);
+        uint32_t target = disp->refr_task->period * 1000;
+        if(target && period >= target + target / 2) dropped_cnt += (period + target / 2) / target - 1;
+    }
+    anim_last = refr_start;
+
+    refr_sum += time_us;
+    if(time_us > refr_max) refr_max = time_us;
+    px_sum += px_num;
+
+    if(now - anim_begin < (uint64_t)anim_time * 1000000) return;
+
+    anim_result_calc(&anim_res[anim_act], now);
+    anim_act++;
+    if(anim_act < anim_cnt) {
+        /*Measure the next scene*/
+        scene_load(&anims[anim_act]);
+        sum_reset();
+        return;
+    }
+
+    anim_run = false;
+    anim_done_cnt = anim_cnt;
+    refr_done = true;
+    disp_drv->monitor_cb = NULL;
+    flush_wrapper_remove(disp_drv);
+
+    /*Go back to the benchmark's screen*/
+    lv_disp_load_scr(lv_obj_get_screen(holder_page));
+    lv_obj_del(scene_scr);
+    scene_scr = NULL;
+    anim_show_result();
+
+    if(ready_cb) ready_cb();
+}
+
+/**
+ * Called after the refreshes of the latency test.
+ * Closes the pending event if its response was drawn in this refresh.
+ * @param disp_drv pointer to the caller display driver
+ * @param time_ms time of rendering in milliseconds (not used, the benchmark's own clock is more precise)
+ * @param px_num Number of pixels drawn
+ */
+static void lat_monitor(lv_disp_drv_t * disp_drv, uint32_t time_ms, uint32_t px_num)
+{
+    (void) time_ms; /*Unused*/
+
+    flush_time = 0;
+    wait_time = 0;
+
+    if(lat_handled) {
+        /*With two buffers the last flush can be still in progress*/
+        while(disp_drv->buffer->flushing);
+        uint64_t end = clock_ns();
+        if(trace_cb) trace_refr(end, px_num);
+
+        lat_pending = false;
+        lat_handled = false;
+        lat_cnt++;
+        if(lat_cnt > warmup_num) {
+            sample_buf[lat_cnt - warmup_num - 1] = (uint32_t)((end - lat_event) / 1000);
+            lat_input_sum += lat_handle - lat_event;
+            lat_refr_sum += end - lat_handle;
+        }
+    } else {
+        if(trace_cb) trace_refr(clock_ns(), px_num);
+    }
+
+    if(lat_cnt < (uint32_t)warmup_num + sample_num) {
+        if(lat_load) lv_obj_invalidate(lv_disp_get_scr_act(lv_obj_get_disp(holder_page)));
+        return;
+    }
+
+    benchmark_latency_result_t * res = &lat_res[lat_load ? 1 : 0];
+    result_calc(&res->latency, sample_buf, sample_num, 0);
+    res->input_avg = (uint32_t)(lat_input_sum / 1000 / sample_num);
+    res->refr_avg = (uint32_t)(lat_refr_sum / 1000 / sample_num);
+
+    if(lat_load == false) {
+        /*Measure again while the whole screen is redrawn on every refresh*/
+        lat_load = true;
+        lat_cnt = 0;
+        lat_input_sum = 0;
+        lat_refr_sum = 0;
+        lv_obj_invalidate(lv_disp_get_scr_act(lv_obj_get_disp(holder_page)));
+        return;
+    }
+
+    lv_task_del(lat_task);
+    lat_task = NULL;
+    lv_indev_enable(lat_indev, false);
+
+    /*Don't leave the button pressed*/
+    lat_pressed = false;
+    lv_btn_set_state(lat_btn, LV_BTN_STATE_REL);
+
+    lat_run = false;
+    lat_valid = true;
+    refr_done = true;
+    disp_drv->monitor_cb = NULL;
+    flush_wrapper_remove(disp_drv);
+    lat_show_result();
+
+    if(ready_cb) ready_cb();
+}
+
+/**
+ * Installed by `benchmark_start()` in place of the display's refresh task
+ * to read the clock right before a refresh starts.
+ * @param task pointer to the display's refresh task
+ */
+static void refr_task_wrapper(lv_task_t * task)
+{
+    lv_disp_t * disp = task->user_data;
+    inv_area_cnt = disp->inv_p;
+
+    /*Measure the merging of the areas before the refresh starts to not count it twice*/
+    join_time = 0;
+    joined_cnt = inv_area_cnt;
+    if(dirty_run && inv_full == false) join_measure(disp);
+
+    if(cnt_cb) cnt_cb(cnt_start);
+    refr_start = clock_ns();
+    render_start = refr_start;
+    lv_disp_refr_task(task);
+}
+
+/**
+ * Merge a copy of the invalidated areas the same way as LittlevGL does at the beginning of the refresh
+ * and save the time of it. The refresh task can't be split as the merging is a static function of LittlevGL.
+ * So it's an estimate which follows `lv_refr_join_area()` of LittlevGL v6: update it if the library's merging changes.
+ * @param disp pointer to the display whose areas should be merged
+ */
+static void join_measure(lv_disp_t * disp)
+{
+    static lv_area_t areas[LV_INV_BUF_SIZE];
+    static uint8_t joined[LV_INV_BUF_SIZE];
+    uint32_t area_cnt = disp->inv_p;
+    if(area_cnt > LV_INV_BUF_SIZE) area_cnt = LV_INV_BUF_SIZE;
+
+    memcpy(areas, disp->inv_areas, area_cnt * sizeof(lv_area_t));
+    memcpy(joined, disp->inv_area_joined, area_cnt);
+
+    uint64_t t_start = clock_ns();
+    uint32_t join_in;
+    uint32_t join_from;
+    lv_area_t joined_area;
+    for(join_in = 0; join_in < area_cnt; join_in++) {
+        if(joined[join_in] != 0) continue;
+
+        for(join_from = 0; join_from < area_cnt; join_from++) {
+            if(joined[join_from] != 0 || join_in == join_from) continue;
+            if(lv_area_is_on(&areas[join_in], &areas[join_from]) == false) continue;
+
+            /*Join two areas only if the joined area is smaller than the two together*/
+            lv_area_join(&joined_area, &areas[join_in], &areas[join_from]);
+            if(lv_area_get_size(&joined_area) < lv_area_get_size(&areas[join_in]) + lv_area_get_size(&areas[join_from])) {
+                areas[join_in] = joined_area;
+                joined[join_from] = 1;
+            }
+        }
+    }
+    join_time = clock_ns() - t_start;
+
+    joined_cnt = 0;
+    for(join_in = 0; join_in < area_cnt; join_in++) {
+        if(joined[join_in] == 0) joined_cnt++;
+    }
+}
+
+/**
+ * Installed by `benchmark_start()` in place of the display's `flush_cb` to measure
+ * the time of flushing and the time of waiting for `lv_disp_flush_ready`.
+ * @param disp_drv pointer to the display driver
+ * @param area the area to flush
+ * @param color_p the rendered pixels of `area`
+ */
+static void flush_wrapper(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    uint64_t t_start = clock_ns();
+    orig_flush_cb(disp_drv, area, color_p);
+    uint64_t t_end = clock_ns();
+    flush_time += (uint32_t)((t_end - t_start) / 1000);
+
+    /* If the flush is still in progress (e.g. DMA) wait for `lv_disp_flush_ready` here.
+     * With one buffer LittlevGL would wait for it right after this anyway.
+     * With two buffers rendering continues in parallel so the wait is counted as rendering.*/
+    if(disp_drv->buffer->flushing && disp_drv->buffer->buf2 == NULL) {
+        uint64_t t_wait = t_end;
+        while(disp_drv->buffer->flushing);
+        t_end = clock_ns();
+        wait_time += (uint32_t)((t_end - t_wait) / 1000);
+        trace(BENCHMARK_TRACE_WAIT, t_wait, t_end, 0, NULL);
+    }
+
+    /*Everything since the start of the refresh or the previous flush was rendering*/
+    trace(BENCHMARK_TRACE_RENDER, render_start, t_start, 0, NULL);
+    trace(BENCHMARK_TRACE_FLUSH, t_start, t_end, lv_area_get_size(area), NULL);
+    render_start = t_end;
+}
+
+/**
+ * Give back the original `flush_cb` and refresh task to the display
+ * @param disp_drv pointer to the display driver
+ */
+static void flush_wrapper_remove(lv_disp_drv_t * disp_drv)
+{
+    if(disp_drv->flush_cb == flush_wrapper) disp_drv->flush_cb = orig_flush_cb;
+
+    lv_disp_t * disp = lv_obj_get_disp(holder_page);
+    disp->refr_task->task_cb = lv_disp_refr_task;
+}
+
+/**
+ * Read the clock set by `benchmark_set_clock_cb()`
+ * @return the current time in nanoseconds
+ */
+static uint64_t clock_ns(void)
+{
+    if(clock_cb) return clock_cb();
+    else return (uint64_t)lv_tick_get() * 1000000;
+}
+
+/**
+ * Update the peak memory usage and fragmentation of the test.
+ * Not available with `LV_MEM_CUSTOM` as `lv_mem_monitor` reports zeros then.
+ */
+static void mem_sample(void)
+{
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+
+    uint32_t used = mon.total_size - mon.free_size;
+    if(used > mem_peak) mem_peak = used;
+    if(mon.frag_pct > frag_max) frag_max = mon.frag_pct;
+}
+
+/**
+ * Give an event to the function set by `benchmark_set_trace_cb()`
+ * @param type a `BENCHMARK_TRACE_...` value
+ * @param start clock value at the start of the event
+ * @param end clock value at the end of the event (same as `start` for instant events and counters)
+ * @param value the value of the event (see `BENCHMARK_TRACE_...`)
+ * @param name static name of the event or NULL
+ */
+static void trace(benchmark_trace_type_t type, uint64_t start, uint64_t end, uint32_t value, const char * name)
+{
+    if(trace_cb == NULL) return;
+
+    benchmark_trace_event_t e;
+    e.type = type;
+    e.start = start;
+    e.dur = (uint32_t)(end - start);
+    e.value = value;
+    e.name = name;
+    trace_cb(&e);
+}
+
+/**
+ * Trace a finished refresh and in every `TRACE_MEM_PERIOD`th refresh the memory usage after it.
+ * Reading the memory usage after every refresh would delay the next one.
+ * @param end clock value at the end of the refresh
+ * @param px_num number of refreshed pixels
+ */
+static void trace_refr(uint64_t end, uint32_t px_num)
+{
+    trace(BENCHMARK_TRACE_REFR, refr_start, end, px_num, NULL);
+
+    trace_refr_cnt++;
+    if(trace_refr_cnt % TRACE_MEM_PERIOD != 1) return;
+
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    trace(BENCHMARK_TRACE_MEM, end, end, mon.total_size - mon.free_size, NULL);
+}
+
+/**
+ * Trace the change of a style feature
+ * @param old_style the style before the change
+ * @param feature name of the changed feature
+ */
+static void trace_style(uint8_t old_style, const char * feature)
+{
+    if(style_act == old_style) return;
+
+    uint64_t now = clock_ns();
+    trace(BENCHMARK_TRACE_STYLE, now, now, style_act, feature);
+}
+
+/**
+ * Called when the "Run test" button is clicked
+ * @param btn pointer to the button
+ * @param event the current event
+ */
+static void run_test_event_cb(lv_obj_t * btn, lv_event_t event)
+{
+    (void) btn; /*Unused*/
+
+    if(event != LV_EVENT_CLICKED) return;
+
+    benchmark_start();
+}
+
+/**
+ * Called when the "Run matrix" button is clicked
+ * @param btn pointer to the button
+ * @param event the current event
+ */
+static void run_matrix_event_cb(lv_obj_t * btn, lv_event_t event)
+{
+    (void) btn; /*Unused*/
+
+    if(event != LV_EVENT_CLICKED) return;
+
+    benchmark_start_matrix();
+}
+
+/**
+ * Called when the "Run scenes" button is clicked
+ * @param btn pointer to the button
+ * @param event the current event
+ */
+static void run_scenes_event_cb(lv_obj_t * btn, lv_event_t event)
+{
+    (void) btn; /*Unused*/
+
+    if(event != LV_EVENT_CLICKED) return;
+
+    uint16_t cnt;
+    const benchmark_scene_t * prim = benchmark_get_prim_scenes(&cnt);
+    benchmark_start_scenes(prim, cnt);
+}
+
+/**
+ * Called when the "Run anim" button is clicked
+ * @param btn pointer to the button
+ * @param event the current event
+ */
+static void run_anim_event_cb(lv_obj_t * btn, lv_event_t event)
+{
+    (void) btn; /*Unused*/
+
+    if(event != LV_EVENT_CLICKED) return;
+
+    uint16_t cnt;
+    const benchmark_scene_t * anim_scenes = benchmark_get_anim_scenes(&cnt);
+    benchmark_start_anim(anim_scenes, cnt);
+}
+
+/**
+ * Called when the "Run anim. engine" button is clicked
+ * @param btn pointer to the button
+ * @param event the current event
+ */
+static void run_engine_event_cb(lv_obj_t * btn, lv_event_t event)
+{
+    (void) btn; /*Unused*/
+
+    if(event != LV_EVENT_CLICKED) return;
+
+    uint16_t cnt;
+    const benchmark_scene_t * engine_scenes = benchmark_get_anim_engine_scenes(&cnt);
+    benchmark_start_anim(engine_scenes, cnt);
+}
+
+/**
+ * Called when the "Run text" button is clicked
+ * @param btn pointer to the button
+ * @param event the current event
+ */
+static void run_text_event_cb(lv_obj_t * btn, lv_event_t event)
+{
+    (void) btn; /*Unused*/
+
+    if(event != LV_EVENT_CLICKED) return;
+
+    uint16_t cnt;
+    const benchmark_scene_t * text_scenes = benchmark_get_text_scenes(&cnt);
+    benchmark_start_scenes(text_scenes, cnt);
+}
+
+/**
+ * Called when the "Run images" button is clicked
+ * @param btn pointer to the button
+ * @param event the current event
+ */
+static void run_img_event_cb(lv_obj_t * btn, lv_event_t event)
+{
+    (void) btn; /*Unused*/
+
+    if(event != LV_EVENT_CLICKED) return;
+
+    uint16_t cnt;
+    const benchmark_scene_t * img_scenes = benchmark_get_img_scenes(&cnt);
+    benchmark_start_scenes(img_scenes, cnt);
+}
+
+/**
+ * Called when the "Run dirty" button is clicked
+ * @param btn pointer to the button
+ * @param event the current event
+ */
+static void run_dirty_event_cb(lv_obj_t * btn, lv_event_t event)
+{
+    (void) btn; /*Unused*/
+
+    if(event != LV_EVENT_CLICKED) return;
+
+    uint16_t cnt;
+    const benchmark_scene_t * dirty_scenes = benchmark_get_dirty_scenes(&cnt);
+    benchmark_start_dirty(dirty_scenes, cnt);
+}
+
+/**
+ * Called when the "Run objects" button is clicked
+ * @param btn pointer to the button
+ * @param event the current event
+ */
+static void run_obj_event_cb(lv_obj_t * btn, lv_event_t event)
+{
+    (void) btn; /*Unused*/
+
+    if(event != LV_EVENT_CLICKED) return;
+
+    benchmark_run_obj_scaling(NULL, 0);
+    obj_show_result();
+}
+
+/**
+ * Called when the "Run layout" button is clicked
+ * @param btn pointer to the button
+ * @param event the current event
+ */
+static void run_layout_event_cb(lv_obj_t * btn, lv_event_t event)
+{
+    (void) btn; /*Unused*/
+
+    if(event != LV_EVENT_CLICKED) return;
+
+    benchmark_run_layout(NULL, 0);
+    layout_show_result();
+}
+
+/**
+ * Called when the "Run styles" button is clicked
+ * @param btn pointer to the button
+ * @param event the current event
+ */
+static void run_style_mod_event_cb(lv_obj_t * btn, lv_event_t event)
+{
+    (void) btn; /*Unused*/
+
+    if(event != LV_EVENT_CLICKED) return;
+
+    benchmark_run_style_mod(NULL, 0);
+    style_mod_show_result();
+}
+
+/**
+ * Called when the "Run latency" button is clicked.
+ * Also called with the events of the virtual input device during the test.
+ * @param btn pointer to the button
+ * @param event the current event
+ */
+static void run_latency_event_cb(lv_obj_t * btn, lv_event_t event)
+{
+    (void) btn; /*Unused*/
+
+    if(lat_indev && lv_indev_get_act() == lat_indev) {
+        /*The button's style is already changed and invalidated*/
+        if((event == LV_EVENT_PRESSED || event == LV_EVENT_RELEASED) && lat_pending && lat_handled == false) {
+            lat_handle = clock_ns();
+            lat_handled = true;
+        }
+        return;
+    }
+
+    if(event != LV_EVENT_CLICKED) return;
+
+    benchmark_start_latency();
+}
+
+/**
+ * Read callback of the virtual input device of the latency test.
+ * It touches the middle of the "Run latency" button.
+ * @param indev_drv pointer to the input device driver
+ * @param data store the position and the state here
+ * @return false: no more data to read
+ */
+static bool lat_read_cb(lv_indev_drv_t * indev_drv, lv_indev_data_t * data)
+{
+    (void) indev_drv; /*Unused*/
+
+    lv_area_t coords;
+    lv_obj_get_coords(lat_btn, &coords);
+    data->point.x = (coords.x1 + coords.x2) / 2;
+    data->point.y = (coords.y1 + coords.y2) / 2;
+    data->state = lat_pressed ? LV_INDEV_STATE_PR : LV_INDEV_STATE_REL;
+
+    return false;
+}
+
+/**
+ * Press or release the virtual input device of the latency test
+ * @param task pointer to the task
+ */
+static void lat_task_cb(lv_task_t * task)
+{
+    /*Wait until the response of the previous event is shown*/
+    if(lat_pending) return;
+
+    lat_pressed = lat_pressed ? false : true;
+    lat_pending = true;
+    lat_handled = false;
+    lat_event = clock_ns();
+
+    /*Vary the period to not measure the same phase of the refresh and input read periods*/
+    lat_rnd = lat_rnd * 1103515245 + 12345;
+    lv_task_set_period(task, LAT_EVENT_PERIOD + (lat_rnd >> 16) % LAT_EVENT_JITTER);
+}
+
+/**
+ * Called when the "Wallpaper" button is clicked
+ * @param btn pointer to the button
+ * @param event the current event
+ */
+static void wp_btn_event_cb(lv_obj_t * btn, lv_event_t event)
+{
+    if(event != LV_EVENT_CLICKED) return;
+
+    wp_set(lv_btn_get_state(btn) == LV_BTN_STATE_TGL_REL ? true : false);
+}
+
+/**
+ * Called when the "Wp. recolor" button is clicked
+ * @param btn pointer to the button
+ * @param event the current event
+ */
+static void recolor_btn_event_cb(lv_obj_t * btn, lv_event_t event)
+{
+    if(event != LV_EVENT_CLICKED) return;
+
+    recolor_set(lv_btn_get_state(btn) == LV_BTN_STATE_TGL_REL ? true : false);
+}
+
+/**
+ * Called when the "Shadow" button is clicked
+ * @param btn pointer to the button
+ * @param event the current event
+ */
+static void shadow_btn_event_cb(lv_obj_t * btn, lv_event_t event)
+{
+    if(event != LV_EVENT_CLICKED) return;
+
+    shadow_set(lv_btn_get_state(btn) == LV_BTN_STATE_TGL_REL ? true : false);
+}
+
+/**
+ * Called when the "Opacity" button is clicked
+ * @param btn pointer to the button
+ * @param event the current event
+ */
+static void opa_btn_event_cb(lv_obj_t * btn, lv_event_t event)
+{
+    if(event != LV_EVENT_CLICKED) return;
+
+    opa_set(lv_btn_get_state(btn) == LV_BTN_STATE_TGL_REL ? true : false);
+}
+
+/**
+ * Show or hide the wallpaper
+ * @param en true: show the wallpaper
+ */
+static void wp_set(bool en)
+{
+    uint8_t old_style = style_act;
+    if(en) style_act |= BENCHMARK_STYLE_WP;
+    else style_act &= ~BENCHMARK_STYLE_WP;
+    trace_style(old_style, "wallpaper");
+
+    lv_obj_set_hidden(wp, en ? false : true);
+}
+
+/**
+ * Enable or disable the re-coloring of the wallpaper
+ * @param en true: re-color the wallpaper
+ */
+static void recolor_set(bool en)
+{
+    uint8_t old_style = style_act;
+    if(en) style_act |= BENCHMARK_STYLE_RECOLOR;
+    else style_act &= ~BENCHMARK_STYLE_RECOLOR;
+    trace_style(old_style, "recolor");
+
+    if(en) style_wp.image.intense = IMG_RECOLOR;
+    else style_wp.image.intense = LV_OPA_TRANSP;
+
+    lv_obj_refresh_style(wp);
+}
+
+/**
+ * Enable or disable the shadow of the buttons
+ * @param en true: draw shadow
+ */
+static void shadow_set(bool en)
+{
+    uint8_t old_style = style_act;
+    if(en) style_act |= BENCHMARK_STYLE_SHADOW;
+    else style_act &= ~BENCHMARK_STYLE_SHADOW;
+    trace_style(old_style, "shadow");
+
+    if(en) {
+        style_btn_rel.body.shadow.width = SHADOW_WIDTH;
+        style_btn_pr.body.shadow.width  =  SHADOW_WIDTH;
+        style_btn_tgl_rel.body.shadow.width = SHADOW_WIDTH;
+        style_btn_tgl_pr.body.shadow.width =  SHADOW_WIDTH;
+    } else {
+        style_btn_rel.body.shadow.width = 0;
+        style_btn_pr.body.shadow.width  = 0;
+        style_btn_tgl_rel.body.shadow.width = 0;
+        style_btn_tgl_pr.body.shadow.width = 0;
+    }
+
+    lv_obj_report_style_mod(&style_btn_rel);
+    lv_obj_report_style_mod(&style_btn_pr);
+    lv_obj_report_style_mod(&style_btn_tgl_rel);
+    lv_obj_report_style_mod(&style_btn_tgl_pr);
+}
+
+/**
+ * Enable or disable the opacity of the buttons
+ * @param en true: make the buttons semi-transparent
+ */
+static void opa_set(bool en)
+{
+    uint8_t old_style = style_act;
+    if(en) style_act |= BENCHMARK_STYLE_OPA;
+    else style_act &= ~BENCHMARK_STYLE_OPA;
+    trace_style(old_style, "opacity");
+
+    if(en) {
+        style_btn_rel.body.opa = OPACITY;
+        style_btn_pr.body.opa  = OPACITY;
+        style_btn_tgl_rel.body.opa = OPACITY;
+        style_btn_tgl_pr.body.opa = OPACITY;
+    } else {
+        style_btn_rel.body.opa = LV_OPA_COVER;
+        style_btn_pr.body.opa  = LV_OPA_COVER;
+        style_btn_tgl_rel.body.opa = LV_OPA_COVER;
+        style_btn_tgl_pr.body.opa = LV_OPA_COVER;
+    }
+
+    lv_obj_report_style_mod(&style_btn_rel);
+    lv_obj_report_style_mod(&style_btn_pr);
+    lv_obj_report_style_mod(&style_btn_tgl_rel);
+    lv_obj_report_style_mod(&style_btn_tgl_pr);
+}
+
+/**
+ * Clear the sums of a test before measuring
+ */
+static void sum_reset(void)
+{
+    refr_cnt = 0;
+    first_time = 0;
+    px_sum = 0;
+    render_sum = 0;
+    flush_sum = 0;
+    wait_sum = 0;
+
+    uint8_t c;
+    for(c = 0; c < BENCHMARK_CNT_NUM; c++) cnt_sum[c] = 0;
+
+    area_sum = 0;
+    join_sum = 0;
+    joined_sum = 0;
+    update_sum = 0;
+
+    mem_peak = 0;
+    frag_max = 0;
+    alloc_start = 0;
+    free_start = 0;
+    if(mem_cnt_cb) mem_cnt_cb(&alloc_start, &free_start);
+    if(mem_peak_cb) {
+        mem_alloc_start = mem_peak_cb(true);
+        lv_mem_monitor_t mon;
+        lv_mem_monitor(&mon);
+        mem_used_start = mon.total_size ? mon.total_size - mon.free_size : mem_alloc_start;
+    }
+
+    period_sum = 0;
+    period_sq_sum = 0;
+    period_max = 0;
+    dropped_cnt = 0;
+    refr_sum = 0;
+    refr_max = 0;
+    period_sample_cnt = 0;
+    period_sample_step = 1;
+    period_idx = 0;
+}
+
+/**
+ * Set the state of a toggle button without sending an event
+ * @param btn pointer to a toggle button
+ * @param en true: toggled state
+ */
+static void tgl_btn_set(lv_obj_t * btn, bool en)
+{
+    lv_btn_set_state(btn, en ? LV_BTN_STATE_TGL_REL : LV_BTN_STATE_REL);
+}
+
+/**
+ * Write the cost of each style feature to the result label
+ */
+static void matrix_show_result(void)
+{
+    char buf[256];
+    sprintf(buf, "Baseline: %d us\n"
+            "Wallpaper: %+d us\n"
+            "Wp. recolor: %+d us\n"
+            "Shadow: %+d us\n"
+            "Opacity: %+d us",
+            (int)matrix_res[0].avg,
+            (int)benchmark_get_feature_cost(BENCHMARK_STYLE_WP),
+            (int)benchmark_get_feature_cost(BENCHMARK_STYLE_RECOLOR),
+            (int)benchmark_get_feature_cost(BENCHMARK_STYLE_SHADOW),
+            (int)benchmark_get_feature_cost(BENCHMARK_STYLE_OPA));
+    lv_label_set_text(result_label, buf);
+
+    benchmark_result_hist_picker_show(BENCHMARK_STYLE_NUM, matrix_name_get);
+}
+
+/**
+ * Create a scene on a new screen, load it and delete the previous scene
+ * @param scene the scene to load
+ * @return the number of pixels returned by the scene's `create_cb`
+ */
+static uint32_t scene_load(const benchmark_scene_t * scene)
+{
+    lv_obj_t * old_scr = scene_scr;
+
+    uint64_t now = clock_ns();
+    trace(BENCHMARK_TRACE_SCENE, now, now, 0, scene->name);
+
+    scene_scr = lv_obj_create(NULL, NULL);
+    uint32_t px = scene->create_cb(scene_scr);
+    lv_disp_load_scr(scene_scr);
+
+    if(old_scr) lv_obj_del(old_scr);
+
+    return px;
+}
+
+/**
+ * Show the time, the cost and the memory usage of each scene in the result table
+ */
+static void scene_show_result(void)
+{
+    lv_obj_t * table = benchmark_result_get_table();
+    char buf[64];
+    sprintf(buf, "%d scenes, average of %d refreshes", scene_done_cnt, sample_num);
+    lv_label_set_text(result_label, buf);
+
+    lv_table_set_col_cnt(table, 7);
+    lv_table_set_row_cnt(table, scene_done_cnt + 1);
+
+    lv_coord_t w = lv_page_get_fit_width(holder_page);
+    lv_table_set_col_width(table, 0, w / 4);
+    uint16_t c;
+    for(c = 1; c < 7; c++) lv_table_set_col_width(table, c, (w - w / 4) / 6);
+
+    static const char * head[] = {"Scene", "First [us]", "Avg. [us]", "p95 [us]", "p99 [us]", "Cost", "Mem. [kB]"};
+    for(c = 0; c < 7; c++) {
+        lv_table_set_cell_value(table, 0, c, head[c]);
+        lv_table_set_cell_type(table, 0, c, 2);
+    }
+
+    uint16_t i;
+    for(i = 0; i < scene_done_cnt; i++) {
+        uint16_t row = i + 1;
+        lv_table_set_cell_value(table, row, 0, scenes[i].name);
+        sprintf(buf, "%d", (int)scene_res[i].first);
+        lv_table_set_cell_value(table, row, 1, buf);
+        sprintf(buf, "%d", (int)scene_res[i].avg);
+        lv_table_set_cell_value(table, row, 2, buf);
+        sprintf(buf, "%d", (int)scene_res[i].p95);
+        lv_table_set_cell_value(table, row, 3, buf);
+        sprintf(buf, "%d", (int)scene_res[i].p99);
+        lv_table_set_cell_value(table, row, 4, buf);
+
+        /*The text scenes are measured per character, the images by their decoding, the others per pixel*/
+        const benchmark_text_result_t * tres = benchmark_get_text_result(i);
+        const benchmark_img_result_t * ires = benchmark_get_img_result(scenes[i].name);
+        if(tres) sprintf(buf, "%d kchar/s", (int)tres->kchar_per_sec);
+        else if(ires) sprintf(buf, "dec. %d us, %d B", (int)ires->decode_time, (int)ires->cache_mem);
+        else sprintf(buf, "%d ns/kpx", (int)benchmark_get_scene_cost(i));
+        lv_table_set_cell_value(table, row, 5, buf);
+
+        sprintf(buf, "%d (%d %%)", (int)(scene_res[i].mem_peak / 1024), scene_res[i].frag_pct);
+        lv_table_set_cell_value(table, row, 6, buf);
+
+        for(c = 0; c < 7; c++) lv_table_set_cell_type(table, row, c, 1);
+    }
+
+    lv_obj_set_hidden(table, false);
+    benchmark_result_hist_picker_show(scene_done_cnt, benchmark_get_scene_name);
+}
+
+/**
+ * Show the result of a single test: the histogram of the refresh times and a table of the statistics
+ */
+static void test_show_result(void)
+{
+    lv_obj_t * table = benchmark_result_get_table();
+    char buf[64];
+    sprintf(buf, "Screen load: %d us (p99: %d us)", (int)result.avg, (int)result.p99);
+    lv_label_set_text(result_label, buf);
+
+    benchmark_result_hist_save(0, sample_buf, sample_num, &result);
+    benchmark_result_hist_show(0);
+
+    lv_coord_t w = lv_page_get_fit_width(holder_page);
+    lv_table_set_col_cnt(table, 2);
+    lv_table_set_row_cnt(table, 9);
+    lv_table_set_col_width(table, 0, w / 3);
+    lv_table_set_col_width(table, 1, w - w / 3);
+
+    sprintf(buf, "%d us of %d", (int)result.avg, sample_num);
+    benchmark_result_table_row_set(0, "Average", buf);
+    sprintf(buf, "%d / %d us", (int)result.min, (int)result.max);
+    benchmark_result_table_row_set(1, "Min. / max.", buf);
+    sprintf(buf, "%d / %d / %d us", (int)result.p50, (int)result.p95, (int)result.p99);
+    benchmark_result_table_row_set(2, "p50 / p95 / p99", buf);
+    sprintf(buf, "%d us", (int)result.std_dev);
+    benchmark_result_table_row_set(3, "Std. dev.", buf);
+    sprintf(buf, "%d px/refr., %d.%02d Mpx/s", (int)result.px_per_refr,
+            (int)(result.kpx_per_sec / 1000), (int)(result.kpx_per_sec % 1000) / 10);
+    benchmark_result_table_row_set(4, "Pixels", buf);
+    sprintf(buf, "%d / %d / %d us", (int)result.render_avg, (int)result.flush_avg, (int)result.wait_avg);
+    benchmark_result_table_row_set(5, "Render / flush / wait", buf);
+    sprintf(buf, "%d us", (int)result.update_avg);
+    benchmark_result_table_row_set(6, "Update", buf);
+    sprintf(buf, "%d kB, %d %% frag.", (int)(result.mem_peak / 1024), result.frag_pct);
+    benchmark_result_table_row_set(7, "Mem. peak", buf);
+    sprintf(buf, "%d / %d", (int)result.alloc_cnt, (int)result.free_cnt);
+    benchmark_result_table_row_set(8, "Alloc / free", buf);
+
+    lv_obj_set_hidden(table, false);
+}
+
+/**
+ * Get the name of a combination of the matrix for `benchmark_result_hist_picker_show()`
+ * @param id the style combination
+ * @return the name of the style combination
+ */
+static const char * matrix_name_get(uint16_t id)
+{
+    return benchmark_get_style_name((uint8_t)id);
+}
+
+/**
+ * Write the partial and full screen refresh time of each scene to the result label
+ */
+static void dirty_show_result(void)
+{
+    char buf[BENCHMARK_SCENE_MAX * 64];
+    uint32_t len = 0;
+    uint16_t i;
+    for(i = 0; i < scene_done_cnt; i++) {
+        len += snprintf(&buf[len], sizeof(buf) - len, "%s%s: %d areas, %d us (full: %d us, merge: %d ns)",
+                        i == 0 ? "" : "\n", scenes[i].name, (int)dirty_res[i].area_avg,
+                        (int)dirty_res[i].partial_avg, (int)dirty_res[i].full_avg, (int)dirty_res[i].join_ns);
+        if(len >= sizeof(buf)) break;
+    }
+    lv_label_set_text(result_label, buf);
+
+    /*The histograms of the partial refreshes*/
+    benchmark_result_hist_picker_show(scene_done_cnt, benchmark_get_scene_name);
+}
+
+/**
+ * Write the time and memory of each object count to the result label
+ */
+static void obj_show_result(void)
+{
+    benchmark_result_view_hide();
+
+    char buf[BENCHMARK_OBJ_RUN_MAX * 64];
+    uint32_t len = 0;
+    uint16_t i;
+    for(i = 0; i < benchmark_get_obj_cnt(); i++) {
+        const benchmark_obj_result_t * res = benchmark_get_obj_result(i);
+        if(res->skipped) {
+            len += snprintf(&buf[len], sizeof(buf) - len, "%s%d: not enough memory",
+                            i == 0 ? "" : "\n", (int)res->obj_num);
+        } else {
+            len += snprintf(&buf[len], sizeof(buf) - len, "%s%d: create %d, render %d, del %d us, %d B/obj",
+                            i == 0 ? "" : "\n", (int)res->obj_num, (int)res->create_time,
+                            (int)res->render_time, (int)res->del_time, (int)res->mem_per_obj);
+        }
+        if(len >= sizeof(buf)) break;
+    }
+    lv_label_set_text(result_label, buf);
+}
+
+/**
+ * Write the layout and fit time of each child count to the result label
+ */
+static void layout_show_result(void)
+{
+    benchmark_result_view_hide();
+
+    char buf[BENCHMARK_OBJ_RUN_MAX * 64];
+    uint32_t len = 0;
+    uint16_t i;
+    for(i = 0; i < benchmark_get_layout_cnt(); i++) {
+        const benchmark_layout_result_t * res = benchmark_get_layout_result(i);
+        if(res->skipped) {
+            len += snprintf(&buf[len], sizeof(buf) - len, "%s%d: not enough memory",
+                            i == 0 ? "" : "\n", (int)res->obj_num);
+        } else {
+            len += snprintf(&buf[len], sizeof(buf) - len, "%s%d: layout %d, fit %d, draw %d us",
+                            i == 0 ? "" : "\n", (int)res->obj_num, (int)res->layout_time,
+                            (int)res->fit_time, (int)res->draw_time);
+        }
+        if(len >= sizeof(buf)) break;
+    }
+    lv_label_set_text(result_label, buf);
+}
+
+/**
+ * Write the walk, propagation and redraw time of each shared style test to the result label
+ */
+static void style_mod_show_result(void)
+{
+    benchmark_result_view_hide();
+
+    char buf[BENCHMARK_OBJ_RUN_MAX * 64];
+    uint32_t len = 0;
+    uint16_t i;
+    for(i = 0; i < benchmark_get_style_mod_cnt(); i++) {
+        const benchmark_style_mod_result_t * res = benchmark_get_style_mod_result(i);
+        if(res->skipped) {
+            len += snprintf(&buf[len], sizeof(buf) - len, "%s%d: not enough memory",
+                            i == 0 ? "" : "\n", (int)res->obj_num);
+        } else {
+            len += snprintf(&buf[len], sizeof(buf) - len, "%s%d: walk %d, propagate %d, draw %d us",
+                            i == 0 ? "" : "\n", (int)res->obj_num, (int)res->walk_time,
+                            (int)res->propagate_time, (int)res->draw_time);
+        }
+        if(len >= sizeof(buf)) break;
+    }
+    lv_label_set_text(result_label, buf);
+}
+
+/**
+ * Write the input latency of the idle and the loaded screen to the result label
+ */
+static void lat_show_result(void)
+{
+    benchmark_result_view_hide();
+
+    char buf[256];
+    uint32_t len = 0;
+    uint8_t i;
+    for(i = 0; i < 2; i++) {
+        const benchmark_latency_result_t * res = &lat_res[i];
+        len += snprintf(&buf[len], sizeof(buf) - len, "%s%s: p50 %d, p95 %d, p99 %d us\n(input %d, refresh %d us)",
+                        i == 0 ? "" : "\n", i == 0 ? "Idle" : "Load", (int)res->latency.p50, (int)res->latency.p95,
+                        (int)res->latency.p99, (int)res->input_avg, (int)res->refr_avg);
+        if(len >= sizeof(buf)) break;
+    }
+    lv_label_set_text(result_label, buf);
+}
+
+/**
+ * Write the frame rate and jitter of each animated scene to the result label
+ */
+static void anim_show_result(void)
+{
+    char buf[BENCHMARK_SCENE_MAX * 80];
+    uint32_t len = 0;
+    uint16_t i;
+    for(i = 0; i < anim_done_cnt; i++) {
+        len += snprintf(&buf[len], sizeof(buf) - len, "%s%s: %d.%d fps, jitter: %d us, dropped: %d",
+                        i == 0 ? "" : "\n", anims[i].name,
+                        (int)anim_res[i].fps_x10 / 10, (int)anim_res[i].fps_x10 % 10,
+                        (int)anim_res[i].jitter, (int)anim_res[i].dropped);
+        if(len >= sizeof(buf)) break;
+
+        /*The animation engine's share of a frame*/
+        const benchmark_anim_tick_result_t * tres = benchmark_get_anim_tick_result(anims[i].name);
+        if(tres) {
+            len += snprintf(&buf[len], sizeof(buf) - len, ", anim: %d us, draw: %d us",
+                            (int)tres->tick_avg, (int)anim_res[i].refr_avg);
+            if(len >= sizeof(buf)) break;
+        }
+    }
+    lv_label_set_text(result_label, buf);
+
+    /*The histograms of the frame periods*/
+    benchmark_result_hist_picker_show(anim_done_cnt, benchmark_get_anim_name);
+}
+
+/**
+ * Calculate the statistics of an animated scene from the sums of its refreshes
+ * @param res store the result here
+ * @param end clock value at the end of the last measured refresh
+ */
+static void anim_result_calc(benchmark_anim_result_t * res, uint64_t end)
+{
+    uint32_t frame_cnt = refr_cnt - warmup_num;
+    uint32_t period_cnt = frame_cnt - 1;
+    uint64_t duration_ns = end - anim_begin;
+
+    res->duration = (uint32_t)(duration_ns / 1000);
+    res->frame_cnt = frame_cnt;
+    res->fps_x10 = duration_ns ? (uint32_t)((uint64_t)frame_cnt * 10000000000ULL / duration_ns) : 0;
+    res->period_max = period_max;
+    res->dropped = dropped_cnt;
+    res->refr_avg = (uint32_t)(refr_sum / frame_cnt);
+    res->refr_max = refr_max;
+    res->px_per_frame = (uint32_t)(px_sum / frame_cnt);
+
+    if(period_cnt) {
+        res->period_avg = (uint32_t)(period_sum / period_cnt);
+        /*Variance = E[x^2] - E[x]^2*/
+        uint64_t sq_avg = period_sq_sum / period_cnt;
+        uint64_t avg_sq = (uint64_t)res->period_avg * res->period_avg;
+        res->jitter = sq_avg > avg_sq ? benchmark_sqrt_u64(sq_avg - avg_sq) : 0;
+    } else {
+        res->period_avg = 0;
+        res->jitter = 0;
+    }
+
+    if(period_sample_cnt) {
+        benchmark_result_t pres;
+        result_calc(&pres, sample_buf, period_sample_cnt, 0);
+        benchmark_result_hist_save(anim_act, sample_buf, period_sample_cnt, &pres);
+    } else {
+        benchmark_result_hist_save(anim_act, NULL, 0, NULL);
+    }
+}
+
+/**
+ * Calculate the statistics of the measured refresh times
+ * @param res store the result here
+ * @param samples the measured times. Will be sorted.
+ * @param cnt number of samples
+ * @param px_total number of pixels refreshed during the samples
+ */
+static void result_calc(benchmark_result_t * res, uint32_t * samples, uint16_t cnt, uint64_t px_total)
+{
+    /*Insertion sort is fine for a few hundred samples*/
+    uint16_t i;
+    for(i = 1; i < cnt; i++) {
+        uint32_t v = samples[i];
+        uint16_t j = i;
+        while(j > 0 && samples[j - 1] > v) {
+            samples[j] = samples[j - 1];
+            j--;
+        }
+        samples[j] = v;
+    }
+
+    uint64_t sum = 0;
+    for(i = 0; i < cnt; i++) sum += samples[i];
+
+    res->sample_cnt = cnt;
+    res->sum = (uint32_t)sum;
+    res->avg = (uint32_t)(sum / cnt);
+    res->min = samples[0];
+    res->max = samples[cnt - 1];
+
+    /*Nearest-rank percentiles*/
+    res->p50 = samples[((uint32_t)cnt * 50 + 99) / 100 - 1];
+    res->p95 = samples[((uint32_t)cnt * 95 + 99) / 100 - 1];
+    res->p99 = samples[((uint32_t)cnt * 99 + 99) / 100 - 1];
+
+    uint64_t sq_sum = 0;
+    for(i = 0; i < cnt; i++) {
+        int64_t d = (int64_t)samples[i] - res->avg;
+        sq_sum += (uint64_t)(d * d);
+    }
+    res->std_dev = benchmark_sqrt_u64(sq_sum / cnt);
+
+    /*Pixels per millisecond is the same as kilopixels per second. The times are in microseconds.*/
+    res->px_per_refr = (uint32_t)(px_total / cnt);
+    res->kpx_per_sec = sum ? (uint32_t)(px_total * 1000 / sum) : 0;
 }
 
 #endif /*LV_USE_BENCHMARK*/
@@ -28,11 +28,235 @@ extern "C" {
 /*********************
  *      DEFINES
  *********************/
+#define BENCHMARK_STYLE_NUM     16      /*Number of the style feature combinations*/
+
+#ifndef BENCHMARK_SAMPLE_MAX
+#define BENCHMARK_SAMPLE_MAX        256     /*Max. number of measured refreshes in a test*/
+#endif
+
+#ifndef BENCHMARK_DEF_WARMUP_NUM
+#define BENCHMARK_DEF_WARMUP_NUM    2       /*Refreshes to drop before measuring*/
+#endif
+
+#ifndef BENCHMARK_DEF_SAMPLE_NUM
+#define BENCHMARK_DEF_SAMPLE_NUM    10      /*Refreshes to measure*/
+#endif
+
+#ifndef BENCHMARK_DEF_ANIM_TIME
+#define BENCHMARK_DEF_ANIM_TIME     10000   /*Time to measure an animated scene [ms]*/
+#endif
+
+#ifndef BENCHMARK_OBJ_RUN_MAX
+#define BENCHMARK_OBJ_RUN_MAX       8       /*Max. number of object counts to try in the object scaling test*/
+#endif
+
+#ifndef BENCHMARK_SCENE_MAX
+#define BENCHMARK_SCENE_MAX         32      /*Max. number of scenes in one run*/
+#endif
 
 /**********************
  *      TYPEDEFS
  **********************/
 
+/*Style features which can be enabled for the test*/
+enum {
+    BENCHMARK_STYLE_WP      = 0x01,     /*Show the wallpaper*/
+    BENCHMARK_STYLE_RECOLOR = 0x02,     /*Re-color the wallpaper*/
+    BENCHMARK_STYLE_SHADOW  = 0x04,     /*Draw shadow on the buttons*/
+    BENCHMARK_STYLE_OPA     = 0x08,     /*Make the buttons semi-transparent*/
+};
+
+/*Hardware counters which can be read around the refreshes*/
+enum {
+    BENCHMARK_CNT_INSTR = 0,            /*Executed instructions*/
+    BENCHMARK_CNT_CYCLE,                /*CPU cycles*/
+    BENCHMARK_CNT_CACHE_MISS,           /*Cache misses*/
+    BENCHMARK_CNT_BRANCH_MISS,          /*Mispredicted branches*/
+    BENCHMARK_CNT_NUM,
+};
+
+/*Statistics of the measured refreshes. All times are in microseconds*/
+typedef struct {
+    uint32_t sample_cnt;    /*Number of measured refreshes*/
+    uint32_t first;         /*Time of the first refresh of the test (before the warm-up is dropped)*/
+    uint32_t sum;           /*Sum of the measured times*/
+    uint32_t avg;
+    uint32_t min;
+    uint32_t max;
+    uint32_t p50;           /*Median*/
+    uint32_t p95;
+    uint32_t p99;
+    uint32_t std_dev;       /*Standard deviation*/
+    uint32_t px_per_refr;   /*Average number of refreshed pixels*/
+    uint32_t kpx_per_sec;   /*Throughput in thousand pixels per second*/
+    uint32_t render_avg;    /*Average time of drawing into the buffer per refresh*/
+    uint32_t flush_avg;     /*Average time spent in the display's `flush_cb` per refresh*/
+    uint32_t wait_avg;      /*Average time of waiting for `lv_disp_flush_ready` per refresh*/
+    uint32_t update_avg;    /*Average time of the scene's `update_cb` per refresh*/
+    uint64_t cnt_avg[BENCHMARK_CNT_NUM];    /*Average change of the hardware counters per refresh*/
+    uint32_t mem_peak;      /*The most `lv_mem` used during the measured refreshes in bytes (inside them, from the warm-up on, only with `benchmark_set_mem_peak_cb()`)*/
+    uint8_t frag_pct;       /*The largest `lv_mem` fragmentation between the measured refreshes*/
+    uint32_t alloc_cnt;     /*Number of allocations during the measured refreshes (needs `benchmark_set_mem_cnt_cb()`)*/
+    uint32_t free_cnt;      /*Number of frees during the measured refreshes (needs `benchmark_set_mem_cnt_cb()`)*/
+} benchmark_result_t;
+
+/*Statistics of an animated scene. All times are in microseconds*/
+typedef struct {
+    uint32_t duration;      /*Measured time*/
+    uint32_t frame_cnt;     /*Number of refreshes*/
+    uint32_t fps_x10;       /*Average frames per second multiplied by 10*/
+    uint32_t period_avg;    /*Average time between the start of two refreshes*/
+    uint32_t period_max;
+    uint32_t jitter;        /*Standard deviation of the time between the refreshes*/
+    uint32_t dropped;       /*Number of missed refresh periods*/
+    uint32_t refr_avg;      /*Average time of a refresh*/
+    uint32_t refr_max;
+    uint32_t px_per_frame;  /*Average number of refreshed pixels*/
+} benchmark_anim_result_t;
+
+/*Input latency measured by `benchmark_start_latency()`. All times are in microseconds*/
+typedef struct {
+    benchmark_result_t latency; /*Statistics of the time from the event to the end of the flush which shows the response*/
+    uint32_t input_avg;         /*Average time from the event until the button handles it (waiting for the input device's read)*/
+    uint32_t refr_avg;          /*Average time from the handling until the end of the flush (waiting for and doing the refresh)*/
+} benchmark_latency_result_t;
+
+/*Cost of the animation engine in a scene with many animations. All times are in microseconds*/
+typedef struct {
+    uint32_t anim_num;      /*Number of running animations*/
+    uint32_t tick_cnt;      /*Number of measured animation ticks*/
+    uint32_t tick_avg;      /*Average time of a tick: calculating and setting the value of every animation (the drawing is not included)*/
+    uint32_t tick_max;
+    uint32_t ns_per_anim;   /*Average tick time per animation in nanoseconds*/
+} benchmark_anim_tick_result_t;
+
+/*Cost of a scene which changes small areas. All times are in microseconds*/
+typedef struct {
+    uint32_t area_avg;      /*Average number of invalidated areas per refresh (before merging them)*/
+    uint32_t update_avg;    /*Average time of changing the objects (incl. invalidation) per refresh*/
+    uint32_t partial_avg;   /*Average refresh time when only the changed areas are redrawn*/
+    uint32_t full_avg;      /*Average refresh time when the whole screen is redrawn*/
+    uint32_t ns_per_area;   /*Partial refresh time per invalidated area in nanoseconds*/
+    uint32_t join_ns;       /*Estimated time of merging the invalidated areas per refresh in nanoseconds.
+                             *An emulation of LittlevGL's merging on a copy of the areas, the real one is in the refresh time.*/
+    uint32_t joined_avg;    /*Average number of areas left after merging them*/
+} benchmark_dirty_result_t;
+
+/*Text throughput of a scene. Only for scenes which tell their number of characters.*/
+typedef struct {
+    uint32_t char_cnt;      /*Number of characters on the screen*/
+    uint32_t kchar_per_sec; /*Rendered characters per second in thousands (from the render time)*/
+    uint32_t ns_per_char;   /*Time of setting and re-wrapping the text (`update_cb`) per character in nanoseconds*/
+} benchmark_text_result_t;
+
+/*Cost of an image source. All times are in microseconds*/
+typedef struct {
+    uint32_t decode_time;   /*Time of opening the image through the image cache (decoding it if the decoder does it at open)*/
+    uint32_t cache_mem;     /*Memory kept by the image cache for the opened image in bytes*/
+} benchmark_img_result_t;
+
+/*Cost of an object count. All times are in microseconds*/
+typedef struct {
+    uint32_t obj_num;       /*Number of buttons. Each has a label too.*/
+    uint32_t create_time;   /*Time of creating the buttons*/
+    uint32_t render_time;   /*Time of the first refresh*/
+    uint32_t del_time;      /*Time of `lv_obj_del`*/
+    uint32_t mem_used;      /*Memory used by the buttons in bytes*/
+    uint32_t mem_per_obj;   /*Memory used by a button with its label in bytes*/
+    uint32_t mem_leak;      /*Memory not freed by the delete in bytes*/
+    uint8_t frag_pct;       /*Memory fragmentation with all the buttons*/
+    bool skipped;           /*There was not enough memory to create the buttons*/
+} benchmark_obj_result_t;
+
+/*Cost of re-layouting a page with a number of children. All times are in microseconds*/
+typedef struct {
+    uint32_t obj_num;       /*Number of buttons on the page. Each has a label too.*/
+    uint32_t build_time;    /*Time of adding the buttons one by one*/
+    uint32_t layout_time;   /*Time of rearranging the children*/
+    uint32_t fit_time;      /*Time of recalculating the size of the scrollable*/
+    uint32_t resize_time;   /*Time of changing the page's width*/
+    uint32_t add_time;      /*Time of adding a button*/
+    uint32_t del_time;      /*Time of deleting a button*/
+    uint32_t draw_time;     /*Time of refreshing the screen after the resize*/
+    bool skipped;           /*There was not enough memory to create the buttons*/
+} benchmark_layout_result_t;
+
+/*Cost of modifying a style shared by a number of objects. All times are in microseconds*/
+typedef struct {
+    uint32_t obj_num;           /*Number of buttons using the style. Each has a label too.*/
+    uint32_t walk_time;         /*Time of `lv_obj_report_style_mod` visiting every object to find the users*/
+    uint32_t propagate_time;    /*Time of refreshing the style of the users (and invalidating them)*/
+    uint32_t draw_time;         /*Time of refreshing the screen after the change*/
+    bool skipped;               /*There was not enough memory to create the buttons*/
+} benchmark_style_mod_result_t;
+
+/*Cost of the task handler with a number of tasks. All times are in microseconds*/
+typedef struct {
+    uint32_t task_num;      /*Number of added tasks with mixed periods and priorities*/
+    uint32_t call_cnt;      /*Number of measured `lv_task_handler` calls*/
+    uint32_t call_avg;      /*Average time of a `lv_task_handler` call*/
+    uint32_t call_max;
+    uint32_t ns_per_task;   /*Average time of a `lv_task_handler` call per added task in nanoseconds*/
+    uint32_t run_cnt;       /*Number of runs of the added tasks*/
+    uint32_t late_avg;      /*Average delay of the tasks compared to their period*/
+    uint32_t late_max;
+    uint32_t jitter;        /*Standard deviation of the delays*/
+    uint8_t idle_true;      /*Percentage of the time spent outside of `lv_task_handler`*/
+    uint8_t idle_reported;  /*Average of `lv_task_get_idle()` in the same time*/
+    bool skipped;           /*There was not enough memory for the tasks*/
+} benchmark_task_result_t;
+
+/*Called when a test is finished*/
+typedef void (*benchmark_ready_cb_t)(void);
+
+/*Returns a monotonic time in nanoseconds*/
+typedef uint64_t (*benchmark_clock_cb_t)(void);
+
+/*Writes the current value of the `BENCHMARK_CNT_NUM` hardware counters to `values`*/
+typedef void (*benchmark_cnt_cb_t)(uint64_t * values);
+
+/*Writes the number of `lv_mem` allocations and frees since an arbitrary point*/
+typedef void (*benchmark_mem_cnt_cb_t)(uint32_t * alloc_cnt, uint32_t * free_cnt);
+
+/*Returns the most bytes allocated at once since the last reset. `reset`: restart from the currently allocated bytes*/
+typedef uint32_t (*benchmark_mem_peak_cb_t)(bool reset);
+
+/*Events reported by `benchmark_set_trace_cb()`*/
+enum {
+    BENCHMARK_TRACE_REFR = 0,           /*Slice: a refresh. `value` is the number of refreshed pixels*/
+    BENCHMARK_TRACE_RENDER,             /*Slice: drawing into the buffer (within a refresh)*/
+    BENCHMARK_TRACE_FLUSH,              /*Slice: the display's `flush_cb` with the wait for `lv_disp_flush_ready` (within a refresh)*/
+    BENCHMARK_TRACE_WAIT,               /*Slice: waiting for `lv_disp_flush_ready` (within a flush)*/
+    BENCHMARK_TRACE_UPDATE,             /*Slice: the scene's `update_cb` (between two refreshes)*/
+    BENCHMARK_TRACE_MEM,                /*Counter: `value` is the used `lv_mem` in bytes after every 16th refresh*/
+    BENCHMARK_TRACE_STYLE,              /*Instant: a style feature is toggled. `name` is the feature, `value` is the new style*/
+    BENCHMARK_TRACE_SCENE,              /*Instant: a scene is loaded. `name` is the scene*/
+};
+typedef uint8_t benchmark_trace_type_t;
+
+/*An event of the benchmark's timeline*/
+typedef struct {
+    benchmark_trace_type_t type;
+    uint64_t start;         /*Clock value in nanoseconds (see `benchmark_set_clock_cb()`)*/
+    uint32_t dur;           /*Duration of slices in nanoseconds*/
+    uint32_t value;
+    const char * name;      /*Static string or NULL*/
+} benchmark_trace_event_t;
+
+/*Receives the events of the benchmark's timeline. Called from the refresh so it should only store the event.*/
+typedef void (*benchmark_trace_cb_t)(const benchmark_trace_event_t * e);
+
+/*Describes a scene to measure*/
+typedef struct {
+    const char * name;
+    /*Create the scene on `scr` and return the number of pixels covered by the
+     *measured drawing (used for the cost per 1000 pixels) or 0 if not relevant*/
+    uint32_t (*create_cb)(lv_obj_t * scr);
+    /*Optional: change the scene before each refresh. `frame` counts the refreshes of the scene.
+     *With `benchmark_start_dirty()` it should change something every time, else there is nothing to refresh.*/
+    void (*update_cb)(uint32_t frame);
+} benchmark_scene_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -48,6 +272,433 @@ bool benchmark_is_ready(void);
 
 uint32_t benchmark_get_refr_time(void);
 
+/**
+ * Set how many refreshes to measure. Applies from the next `benchmark_start()`.
+ * @param warmup number of refreshes to drop at the beginning (e.g. to fill the caches)
+ * @param sample number of refreshes to measure. Limited to `BENCHMARK_SAMPLE_MAX`.
+ */
+void benchmark_set_sample_num(uint16_t warmup, uint16_t sample);
+
+/**
+ * Set a function to call when a test (or the whole matrix) is finished.
+ * This way `benchmark_is_ready()` doesn't need to be polled.
+ * @param cb the callback or NULL to not use it
+ */
+void benchmark_set_ready_cb(benchmark_ready_cb_t cb);
+
+/**
+ * Set a high resolution clock to measure the refreshes with.
+ * Without it `lv_tick_get()` is used which has only millisecond resolution.
+ * @param cb a function returning a monotonic time in nanoseconds or NULL to use `lv_tick_get()`
+ */
+void benchmark_set_clock_cb(benchmark_clock_cb_t cb);
+
+/**
+ * Set a function to read hardware counters (e.g. instructions, cache misses) with.
+ * They are read before and after each refresh and their average change per refresh
+ * is stored in `benchmark_result_t.cnt_avg`.
+ * @param cb a function writing the `BENCHMARK_CNT_NUM` counter values to its parameter
+ *           or NULL to not read counters
+ */
+void benchmark_set_cnt_cb(benchmark_cnt_cb_t cb);
+
+/**
+ * Set a function to count the `lv_mem` allocations and frees with (e.g. by wrapping `lv_mem_alloc`).
+ * They are read before and after the measured refreshes and their change
+ * is stored in `benchmark_result_t.alloc_cnt/free_cnt`.
+ * @param cb a function writing the allocation and free counts to its parameters or NULL to not count them
+ */
+void benchmark_set_mem_cnt_cb(benchmark_mem_cnt_cb_t cb);
+
+/**
+ * Set a function to follow the peak `lv_mem` usage with (e.g. by wrapping `lv_mem_alloc`).
+ * Without it the usage is sampled only between the refreshes so the memory allocated and freed
+ * while drawing (e.g. by an image decoder) is not seen in `benchmark_result_t.mem_peak`.
+ * @param cb a function returning the peak allocated bytes or NULL to sample between the refreshes only
+ */
+void benchmark_set_mem_peak_cb(benchmark_mem_peak_cb_t cb);
+
+/**
+ * Set a function to receive the timeline of the tests: the refreshes with their rendering and flushing,
+ * the scenes' updates, the memory usage and the changes of the style features and scenes.
+ * E.g. to write them as a trace to see the stalls of a test.
+ * @param cb a function storing the events or NULL to not trace
+ */
+void benchmark_set_trace_cb(benchmark_trace_cb_t cb);
+
+/**
+ * Read the clock set by `benchmark_set_clock_cb()`
+ * @return the current time in nanoseconds
+ */
+uint64_t benchmark_get_time_ns(void);
+
+/**
+ * Get the statistics of the last test
+ * @return pointer to the result or NULL if the test is not ready
+ */
+const benchmark_result_t * benchmark_get_result(void);
+
+/**
+ * Enable or disable the style features (wallpaper, recolor, shadow, opacity) at once.
+ * The toggle buttons are updated too.
+ * @param style OR-ed values of `BENCHMARK_STYLE_...`
+ */
+void benchmark_set_style(uint8_t style);
+
+/**
+ * Get the currently enabled style features
+ * @return OR-ed values of `BENCHMARK_STYLE_...`
+ */
+uint8_t benchmark_get_style(void);
+
+/**
+ * Get the name of a style combination, e.g. "wp+shadow"
+ * @param style OR-ed values of `BENCHMARK_STYLE_...`
+ * @return the name in a static buffer
+ */
+const char * benchmark_get_style_name(uint8_t style);
+
+/**
+ * Run the test with all the `BENCHMARK_STYLE_NUM` combinations of the style features one after the other.
+ * `benchmark_is_ready()` returns `true` when all of them are finished.
+ * The original style is restored at the end.
+ */
+void benchmark_start_matrix(void);
+
+/**
+ * Tell whether all the style combinations are measured by `benchmark_start_matrix()`
+ * @return true: the matrix results are available
+ */
+bool benchmark_matrix_is_valid(void);
+
+/**
+ * Get the average refresh time of a style combination measured by `benchmark_start_matrix()`
+ * @param style OR-ed values of `BENCHMARK_STYLE_...`
+ * @return the refresh time in microseconds or 0 if the matrix is not measured yet
+ */
+uint32_t benchmark_get_matrix_time(uint8_t style);
+
+/**
+ * Get the statistics of a style combination measured by `benchmark_start_matrix()`
+ * @param style OR-ed values of `BENCHMARK_STYLE_...`
+ * @return pointer to the result or NULL if the matrix is not measured yet
+ */
+const benchmark_result_t * benchmark_get_matrix_result(uint8_t style);
+
+/**
+ * Get how much a style feature adds to the refresh time.
+ * It's the average difference between the combinations with and without the feature
+ * so the interaction with the other features is also considered.
+ * @param feature a `BENCHMARK_STYLE_...` value
+ * @return the extra time in microseconds (can be negative) or 0 if the matrix is not measured yet
+ */
+int32_t benchmark_get_feature_cost(uint8_t feature);
+
+/**
+ * Measure scenes one after the other. Each scene is created on a new screen
+ * which is deleted when its test is finished.
+ * `benchmark_is_ready()` returns `true` when all of them are finished.
+ * @param scene_array the scenes to run. The first should be an empty scene
+ *                    as the costs are calculated relative to it.
+ *                    Only the pointer is saved so it should be static.
+ * @param cnt number of scenes in `scene_array`. Limited to `BENCHMARK_SCENE_MAX`.
+ */
+void benchmark_start_scenes(const benchmark_scene_t * scene_array, uint16_t cnt);
+
+/**
+ * Get the number of scenes measured by `benchmark_start_scenes()`
+ * @return number of scenes or 0 if not ready yet
+ */
+uint16_t benchmark_get_scene_cnt(void);
+
+/**
+ * Get the name of a measured scene
+ * @param id index of the scene
+ * @return name of the scene or NULL if `id` is invalid
+ */
+const char * benchmark_get_scene_name(uint16_t id);
+
+/**
+ * Get the statistics of a measured scene
+ * @param id index of the scene
+ * @return pointer to the result or NULL if `id` is invalid
+ */
+const benchmark_result_t * benchmark_get_scene_result(uint16_t id);
+
+/**
+ * Get the cost of drawing 1000 pixels in a scene.
+ * The time of the first (empty) scene is subtracted.
+ * @param id index of the scene
+ * @return nanoseconds per 1000 pixels or 0 if the scene doesn't tell its pixel count
+ */
+uint32_t benchmark_get_scene_cost(uint16_t id);
+
+/**
+ * Get the scenes which measure one drawing primitive each (rectangle, gradient, shadow, image, text, etc.)
+ * @param cnt store the number of scenes here
+ * @return the array of scenes. The first is an empty screen.
+ */
+const benchmark_scene_t * benchmark_get_prim_scenes(uint16_t * cnt);
+
+/**
+ * Tell the number of characters in the current scene. Call it from the scene's `create_cb` or `update_cb`.
+ * Scenes which call it get a `benchmark_text_result_t` too.
+ * @param cnt number of characters (not bytes) on the screen
+ */
+void benchmark_set_scene_char_cnt(uint32_t cnt);
+
+/**
+ * Get the text throughput of a scene measured by `benchmark_start_scenes()`
+ * @param id index of the scene
+ * @return pointer to the result or NULL if `id` is invalid or the scene didn't tell its number of characters
+ */
+const benchmark_text_result_t * benchmark_get_text_result(uint16_t id);
+
+/**
+ * Get the scenes which change and re-wrap text before every refresh (long texts with several fonts,
+ * recolored text, a terminal-like log, many `lv_label_set_text`). Use them with `benchmark_start_scenes()`.
+ * @param cnt store the number of scenes here
+ * @return the array of scenes
+ */
+const benchmark_scene_t * benchmark_get_text_scenes(uint16_t * cnt);
+
+/**
+ * Get the scenes which draw the same image from different sources: the C array (`img_array`),
+ * a file read through the built-in decoder on every draw (`img_file`)
+ * and the file decoded into RAM once and kept in the image cache (`img_cached`).
+ * Use them with `benchmark_start_scenes()` and get the decoding cost with `benchmark_get_img_result()`.
+ * The file scenes need `LV_USE_FILESYSTEM`.
+ * @param cnt store the number of scenes here
+ * @return the array of scenes
+ */
+const benchmark_scene_t * benchmark_get_img_scenes(uint16_t * cnt);
+
+/**
+ * Get the decoding cost of an image scene measured by `benchmark_start_scenes()`
+ * @param name name of the scene
+ * @return pointer to the result or NULL if `name` is not a measured image scene
+ */
+const benchmark_img_result_t * benchmark_get_img_result(const char * name);
+
+#if LV_USE_FILESYSTEM
+/**
+ * Set the image file of the file scenes. By default a RAM drive serves `benchmark_bg` as a file
+ * so only the cost of the decoder is measured. Set a file on the real storage to measure the reading too.
+ * @param path path of an image converted to LittlevGL's binary format (`.bin`) with true color format.
+ *             Only the pointer is saved so it should be static.
+ */
+void benchmark_set_img_file(const char * path);
+#endif
+
+/**
+ * Measure scenes which change small parts of the screen before every refresh (`update_cb` of the scenes).
+ * Each scene is measured twice: first only the changed areas are redrawn,
+ * then the whole screen is invalidated too as in the other tests.
+ * `benchmark_get_scene_...()` return the first, `benchmark_get_dirty_result()` compares the two.
+ * `benchmark_is_ready()` returns `true` when all of them are finished.
+ * @param scene_array the scenes to run. Only the pointer is saved so it should be static.
+ * @param cnt number of scenes in `scene_array`. Limited to `BENCHMARK_SCENE_MAX`.
+ */
+void benchmark_start_dirty(const benchmark_scene_t * scene_array, uint16_t cnt);
+
+/**
+ * Get the comparison of partial and full screen redraw of a scene measured by `benchmark_start_dirty()`
+ * @param id index of the scene
+ * @return pointer to the result or NULL if `id` is invalid or the last scenes were not started by `benchmark_start_dirty()`
+ */
+const benchmark_dirty_result_t * benchmark_get_dirty_result(uint16_t id);
+
+/**
+ * Get the scenes which change many small, scattered objects before every refresh
+ * (blinking cursors, clock labels, progress bars). Use them with `benchmark_start_dirty()`.
+ * @param cnt store the number of scenes here
+ * @return the array of scenes
+ */
+const benchmark_scene_t * benchmark_get_dirty_scenes(uint16_t * cnt);
+
+/**
+ * Measure how the cost of the objects scales with their number.
+ * For each number a page with that many buttons (each with a label) is created on a new screen,
+ * rendered once and deleted. The time of each step and the used memory are saved.
+ * It runs synchronously and leaves the original screen loaded.
+ * A number is skipped if it wouldn't fit into the memory according to the smaller numbers.
+ * @param nums the number of buttons to try in increasing order or NULL to use 10, 100, 1000, 10000
+ * @param cnt number of elements in `nums`. Limited to `BENCHMARK_OBJ_RUN_MAX`.
+ */
+void benchmark_run_obj_scaling(const uint32_t * nums, uint16_t cnt);
+
+/**
+ * Get the number of results of `benchmark_run_obj_scaling()`
+ * @return number of results
+ */
+uint16_t benchmark_get_obj_cnt(void);
+
+/**
+ * Get a result of `benchmark_run_obj_scaling()`
+ * @param id index of the result
+ * @return pointer to the result or NULL if `id` is invalid
+ */
+const benchmark_obj_result_t * benchmark_get_obj_result(uint16_t id);
+
+/**
+ * Measure the re-layout of a page with `LV_LAYOUT_PRETTY` (like the benchmark's own page) for different numbers of children.
+ * For each number a page with that many buttons is created and the following are measured (averaged on a few repeats):
+ * - fit: recalculating the size of the scrollable only (setting `LV_LAYOUT_OFF`)
+ * - layout: rearranging the children (setting `LV_LAYOUT_PRETTY` minus the fit)
+ * - resize, add, delete: changing the page's width, adding a button, deleting a button (with the re-layout they cause)
+ * - draw: refreshing the screen after a resize
+ * It runs synchronously and leaves the original screen loaded.
+ * @param nums the number of buttons to try in increasing order or NULL to use 10, 50, 100, 500, 1000, 2000
+ * @param cnt number of elements in `nums`. Limited to `BENCHMARK_OBJ_RUN_MAX`.
+ */
+void benchmark_run_layout(const uint32_t * nums, uint16_t cnt);
+
+/**
+ * Get the number of results of `benchmark_run_layout()`
+ * @return number of results
+ */
+uint16_t benchmark_get_layout_cnt(void);
+
+/**
+ * Get a result of `benchmark_run_layout()`
+ * @param id index of the result
+ * @return pointer to the result or NULL if `id` is invalid
+ */
+const benchmark_layout_result_t * benchmark_get_layout_result(uint16_t id);
+
+/**
+ * Measure the cost of modifying a style which is shared by many objects (like the styles of a theme).
+ * For each number a page with that many buttons using the same style is created
+ * and the color of the style is changed a few times. The following are measured (averaged on the repeats):
+ * - walk: `lv_obj_report_style_mod()` with a style which is not used by any object. It only visits every object.
+ * - propagate: `lv_obj_report_style_mod()` with the shared style minus the walk (refreshing and invalidating the users)
+ * - draw: refreshing the screen after the change
+ * It runs synchronously and leaves the original screen loaded.
+ * @param nums the number of buttons to try in increasing order or NULL to use 10, 100, 1000, 10000
+ * @param cnt number of elements in `nums`. Limited to `BENCHMARK_OBJ_RUN_MAX`.
+ */
+void benchmark_run_style_mod(const uint32_t * nums, uint16_t cnt);
+
+/**
+ * Get the number of results of `benchmark_run_style_mod()`
+ * @return number of results
+ */
+uint16_t benchmark_get_style_mod_cnt(void);
+
+/**
+ * Get a result of `benchmark_run_style_mod()`
+ * @param id index of the result
+ * @return pointer to the result or NULL if `id` is invalid
+ */
+const benchmark_style_mod_result_t * benchmark_get_style_mod_result(uint16_t id);
+
+/**
+ * Measure how the cost of the task handler scales with the number of tasks.
+ * For each number that many tasks are created with mixed periods (10 ms to 1 s) and priorities.
+ * Then `lv_task_handler()` is called for a few seconds with a 5 ms wait between the calls (like in a main loop)
+ * and the following are measured:
+ * - the time of the `lv_task_handler()` calls (the tasks do nothing else than saving their delay)
+ * - the delay of the tasks compared to their period and its standard deviation (jitter)
+ * - the time spent outside of `lv_task_handler()` (true idle) and `lv_task_get_idle()` in the same time
+ * It calls `lv_task_handler()` itself so it should be called outside of it (e.g. from `main()`),
+ * not from an event or a task. The benchmark's screen should be idle (not running a test).
+ * @param nums the number of tasks to try in increasing order or NULL to use 10, 100, 1000, 10000
+ * @param cnt number of elements in `nums`. Limited to `BENCHMARK_OBJ_RUN_MAX`.
+ */
+void benchmark_run_tasks(const uint32_t * nums, uint16_t cnt);
+
+/**
+ * Get the number of results of `benchmark_run_tasks()`
+ * @return number of results
+ */
+uint16_t benchmark_get_task_cnt(void);
+
+/**
+ * Get a result of `benchmark_run_tasks()`
+ * @param id index of the result
+ * @return pointer to the result or NULL if `id` is invalid
+ */
+const benchmark_task_result_t * benchmark_get_task_result(uint16_t id);
+
+/**
+ * Measure the time from a touch until the display shows the response (touch-to-photon latency).
+ * A virtual pointer input device presses and releases the "Run latency" button of the benchmark
+ * in slightly varying periods (to not follow the refresh and the input read periods in lockstep).
+ * The latency is the time from changing the state of the virtual device to the end of the flush after the
+ * button changed its style. It's measured first with the screen idle and then with the whole screen redrawn on every refresh (load).
+ * Both use the warm-up and sample numbers of `benchmark_set_sample_num()` as number of events.
+ * `benchmark_is_ready()` returns `true` when both are finished.
+ */
+void benchmark_start_latency(void);
+
+/**
+ * Get the result of `benchmark_start_latency()`
+ * @param load false: the result with the screen idle; true: the result with the whole screen redrawn on every refresh
+ * @return pointer to the result or NULL if the latency is not measured yet
+ */
+const benchmark_latency_result_t * benchmark_get_latency_result(bool load);
+
+/**
+ * Set how long to measure each animated scene. Applies from the next `benchmark_start_anim()`.
+ * @param time_ms measure time in milliseconds
+ */
+void benchmark_set_anim_time(uint32_t time_ms);
+
+/**
+ * Measure scenes with continuous animations one after the other.
+ * Unlike the other tests the screen is not invalidated, only the animations redraw what they change.
+ * Each scene is measured for the time set by `benchmark_set_anim_time()`.
+ * `benchmark_is_ready()` returns `true` when all of them are finished.
+ * @param scene_array the scenes to run. Only the pointer is saved so it should be static.
+ * @param cnt number of scenes in `scene_array`. Limited to `BENCHMARK_SCENE_MAX`.
+ */
+void benchmark_start_anim(const benchmark_scene_t * scene_array, uint16_t cnt);
+
+/**
+ * Get the number of scenes measured by `benchmark_start_anim()`
+ * @return number of scenes or 0 if not ready yet
+ */
+uint16_t benchmark_get_anim_cnt(void);
+
+/**
+ * Get the name of a measured animated scene
+ * @param id index of the scene
+ * @return name of the scene or NULL if `id` is invalid
+ */
+const char * benchmark_get_anim_name(uint16_t id);
+
+/**
+ * Get the statistics of a measured animated scene
+ * @param id index of the scene
+ * @return pointer to the result or NULL if `id` is invalid
+ */
+const benchmark_anim_result_t * benchmark_get_anim_result(uint16_t id);
+
+/**
+ * Get the scenes which animate continuously (scrolling, sliding objects, bouncing image).
+ * Use them with `benchmark_start_anim()`.
+ * @param cnt store the number of scenes here
+ * @return the array of scenes
+ */
+const benchmark_scene_t * benchmark_get_anim_scenes(uint16_t * cnt);
+
+/**
+ * Get the scenes which run many animations at once to measure the animation engine (`lv_anim`):
+ * 1, 10, 100, 1000 and 5000 small objects animating their position, opacity or size in turns (`anim_<num>`)
+ * and 1000 animations of only one of these properties (`anim_pos_1000`, `anim_opa_1000`, `anim_size_1000`).
+ * Use them with `benchmark_start_anim()` and get the time of the animation ticks with `benchmark_get_anim_tick_result()`.
+ * @param cnt store the number of scenes here
+ * @return the array of scenes
+ */
+const benchmark_scene_t * benchmark_get_anim_engine_scenes(uint16_t * cnt);
+
+/**
+ * Get the cost of the animation ticks in an animation engine scene measured by `benchmark_start_anim()`
+ * @param name name of the scene
+ * @return pointer to the result or NULL if `name` is not a measured animation engine scene
+ */
+const benchmark_anim_tick_result_t * benchmark_get_anim_tick_result(const char * name);
+
 /**********************
  *      MACROS
  **********************/
@@ -1,5 +1,14 @@
 CSRCS += lv_benchmark.c
+CSRCS += lv_benchmark_result.c
 CSRCS += lv_benchmark_bg.c
+CSRCS += lv_benchmark_scenes.c
+CSRCS += lv_benchmark_anim.c
+CSRCS += lv_benchmark_dirty.c
+CSRCS += lv_benchmark_obj.c
+CSRCS += lv_benchmark_text.c
+CSRCS += lv_benchmark_img.c
+CSRCS += lv_benchmark_task.c
+CSRCS += lv_benchmark_headless.c
 
 DEPPATH += --dep-path $(LVGL_DIR)/lv_apps/lv_benchmark
 VPATH += :$(LVGL_DIR)/lv_apps/lv_benchmark
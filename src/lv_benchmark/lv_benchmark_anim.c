@@ -0,0 +1,472 @@
+/**
+ * @file lv_benchmark_anim.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_benchmark_internal.h"
+#if LV_USE_BENCHMARK
+
+#include <stdio.h>
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define SCROLL_BTN_NUM      40
+#define SCROLL_TIME         3000    /*Time of scrolling from the top to the bottom [ms]*/
+#define SLIDE_ROW_NUM       6
+#define SLIDE_TIME          1500    /*Time of sliding through the screen [ms]*/
+#define SLIDE_DELAY         150     /*Delay between the rows [ms]*/
+#define BOUNCE_X_TIME       1700    /*Time of moving from the left to the right [ms]*/
+#define BOUNCE_Y_TIME       1100    /*Time of moving from the top to the bottom [ms]*/
+#define ENGINE_OBJ_SIZE     (LV_DPI / 8)
+#define ENGINE_MOVE         (LV_DPI / 2)    /*Distance of moving and growing the objects*/
+#define ENGINE_TIME         1000    /*Time of one direction of the animations [ms]*/
+#define ENGINE_WARMUP       2       /*Animation ticks to drop after creating a scene*/
+#define ENGINE_SCENE_NUM    (sizeof(engine_scenes) / sizeof(engine_scenes[0]))
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*The animated property of the objects in the animation engine scenes*/
+enum {
+    ENGINE_POS,
+    ENGINE_OPA,
+    ENGINE_SIZE,
+    ENGINE_MIXED,   /*Every object animates one of the above in turns*/
+};
+typedef uint8_t engine_prop_t;
+
+/*Settings of an animation engine scene*/
+typedef struct {
+    uint16_t anim_num;
+    engine_prop_t prop;
+} engine_cfg_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static uint32_t scroll_create(lv_obj_t * scr);
+static uint32_t slide_create(lv_obj_t * scr);
+static uint32_t bounce_create(lv_obj_t * scr);
+static uint32_t engine_1_create(lv_obj_t * scr);
+static uint32_t engine_10_create(lv_obj_t * scr);
+static uint32_t engine_100_create(lv_obj_t * scr);
+static uint32_t engine_1000_create(lv_obj_t * scr);
+static uint32_t engine_5000_create(lv_obj_t * scr);
+static uint32_t engine_pos_create(lv_obj_t * scr);
+static uint32_t engine_opa_create(lv_obj_t * scr);
+static uint32_t engine_size_create(lv_obj_t * scr);
+static uint32_t engine_create(lv_obj_t * scr, uint16_t id);
+static void engine_scr_event_cb(lv_obj_t * scr, lv_event_t event);
+static void engine_finish(void);
+static void probe_first_cb(void * var, lv_anim_value_t value);
+static void probe_last_cb(void * var, lv_anim_value_t value);
+static void probe_reached(uint8_t probe);
+static void anim_start(void * var, lv_anim_exec_xcb_t exec_cb, lv_coord_t start, lv_coord_t end,
+                       uint16_t time, int16_t delay, lv_anim_path_cb_t path_cb);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static const benchmark_scene_t anim_scenes[] = {
+    {"scroll", scroll_create, NULL},
+    {"slide", slide_create, NULL},
+    {"bounce", bounce_create, NULL},
+};
+
+static const benchmark_scene_t engine_scenes[] = {
+    {"anim_1", engine_1_create, NULL},
+    {"anim_10", engine_10_create, NULL},
+    {"anim_100", engine_100_create, NULL},
+    {"anim_1000", engine_1000_create, NULL},
+    {"anim_5000", engine_5000_create, NULL},
+    {"anim_pos_1000", engine_pos_create, NULL},
+    {"anim_opa_1000", engine_opa_create, NULL},
+    {"anim_size_1000", engine_size_create, NULL},
+};
+
+/*The same order as `engine_scenes`*/
+static const engine_cfg_t engine_cfg[] = {
+    {1, ENGINE_MIXED},
+    {10, ENGINE_MIXED},
+    {100, ENGINE_MIXED},
+    {1000, ENGINE_MIXED},
+    {5000, ENGINE_MIXED},
+    {1000, ENGINE_POS},
+    {1000, ENGINE_OPA},
+    {1000, ENGINE_SIZE},
+};
+
+static benchmark_anim_tick_result_t engine_res[ENGINE_SCENE_NUM];
+static bool engine_res_valid[ENGINE_SCENE_NUM];
+static uint64_t engine_tick_sum;    /*Time of the measured ticks of the running scene [ns]*/
+static uint16_t engine_act;         /*The scene whose animations are running*/
+static lv_obj_t * engine_scr;       /*Screen of the running scene or NULL if it's finished*/
+static uint32_t engine_tick_total;  /*Number of ticks since creating the scene*/
+static uint8_t probe_seen;          /*The probes reached in the current tick (bit 0: first, bit 1: last)*/
+static uint64_t probe_time[2];      /*Clock value when the probes were reached*/
+static lv_style_t style_engine;
+
+LV_IMG_DECLARE(benchmark_bg)
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Get the scenes which animate continuously (scrolling, sliding objects, bouncing image).
+ * Use them with `benchmark_start_anim()`.
+ * @param cnt store the number of scenes here
+ * @return the array of scenes
+ */
+const benchmark_scene_t * benchmark_get_anim_scenes(uint16_t * cnt)
+{
+    *cnt = sizeof(anim_scenes) / sizeof(anim_scenes[0]);
+    return anim_scenes;
+}
+
+/**
+ * Get the scenes which run many animations at once to measure the animation engine (`lv_anim`):
+ * 1, 10, 100, 1000 and 5000 small objects animating their position, opacity or size in turns (`anim_<num>`)
+ * and 1000 animations of only one of these properties (`anim_pos_1000`, `anim_opa_1000`, `anim_size_1000`).
+ * Use them with `benchmark_start_anim()` and get the time of the animation ticks with `benchmark_get_anim_tick_result()`.
+ * @param cnt store the number of scenes here
+ * @return the array of scenes
+ */
+const benchmark_scene_t * benchmark_get_anim_engine_scenes(uint16_t * cnt)
+{
+    *cnt = ENGINE_SCENE_NUM;
+    return engine_scenes;
+}
+
+/**
+ * Get the cost of the animation ticks in an animation engine scene measured by `benchmark_start_anim()`
+ * @param name name of the scene
+ * @return pointer to the result or NULL if `name` is not a measured animation engine scene
+ */
+const benchmark_anim_tick_result_t * benchmark_get_anim_tick_result(const char * name)
+{
+    uint16_t i;
+    for(i = 0; i < ENGINE_SCENE_NUM; i++) {
+        if(strcmp(engine_scenes[i].name, name) == 0) {
+            if(engine_res_valid[i] == false || engine_res[i].tick_cnt == 0) return NULL;
+
+            return &engine_res[i];
+        }
+    }
+
+    return NULL;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Scroll a page of buttons (like the benchmark's own page) up and down
+ * @param scr pointer to the scene's screen
+ * @return 0: the redrawn area depends on the scroll position
+ */
+static uint32_t scroll_create(lv_obj_t * scr)
+{
+    lv_coord_t hres = lv_disp_get_hor_res(NULL);
+    lv_coord_t vres = lv_disp_get_ver_res(NULL);
+
+    lv_obj_t * page = lv_page_create(scr, NULL);
+    lv_obj_set_size(page, hres, vres);
+    lv_page_set_scrl_layout(page, LV_LAYOUT_PRETTY);
+
+    uint16_t i;
+    for(i = 0; i < SCROLL_BTN_NUM; i++) {
+        lv_obj_t * btn = lv_btn_create(page, NULL);
+        lv_btn_set_fit(btn, LV_FIT_TIGHT);
+
+        char buf[32];
+        sprintf(buf, "Button %d", i + 1);
+        lv_obj_t * label = lv_label_create(btn, NULL);
+        lv_label_set_text(label, buf);
+    }
+
+    lv_obj_t * scrl = lv_page_get_scrl(page);
+    lv_coord_t scrl_end = vres - lv_obj_get_height(scrl);
+    if(scrl_end > 0) scrl_end = 0;
+
+    anim_start(scrl, (lv_anim_exec_xcb_t)lv_obj_set_y, 0, scrl_end, SCROLL_TIME, 0, lv_anim_path_ease_in_out);
+
+    return 0;
+}
+
+/**
+ * Buttons sliding through the screen one after the other
+ * @param scr pointer to the scene's screen
+ * @return 0: the redrawn area changes continuously
+ */
+static uint32_t slide_create(lv_obj_t * scr)
+{
+    lv_coord_t hres = lv_disp_get_hor_res(NULL);
+    lv_coord_t vres = lv_disp_get_ver_res(NULL);
+    lv_coord_t row_h = vres / SLIDE_ROW_NUM;
+    lv_coord_t w = hres / 3;
+
+    uint16_t i;
+    for(i = 0; i < SLIDE_ROW_NUM; i++) {
+        lv_obj_t * btn = lv_btn_create(scr, NULL);
+        lv_obj_set_size(btn, w, row_h - row_h / 5);
+        lv_obj_set_pos(btn, -w, i * row_h + row_h / 10);
+
+        lv_obj_t * label = lv_label_create(btn, NULL);
+        lv_label_set_text(label, "Slide");
+
+        anim_start(btn, (lv_anim_exec_xcb_t)lv_obj_set_x, -w, hres, SLIDE_TIME, i * SLIDE_DELAY, lv_anim_path_ease_in_out);
+    }
+
+    return 0;
+}
+
+/**
+ * An image bouncing between the edges of the screen
+ * @param scr pointer to the scene's screen
+ * @return 0: the redrawn area changes continuously
+ */
+static uint32_t bounce_create(lv_obj_t * scr)
+{
+    lv_coord_t hres = lv_disp_get_hor_res(NULL);
+    lv_coord_t vres = lv_disp_get_ver_res(NULL);
+    lv_coord_t w = hres / 2;
+    lv_coord_t h = vres / 2;
+
+    lv_obj_t * img = lv_img_create(scr, NULL);
+    lv_img_set_src(img, &benchmark_bg);
+    lv_img_set_auto_size(img, false);
+    lv_obj_set_size(img, w, h);
+
+    /*Different times on the axes so the image doesn't move on the same line all the time*/
+    anim_start(img, (lv_anim_exec_xcb_t)lv_obj_set_x, 0, hres - w, BOUNCE_X_TIME, 0, lv_anim_path_linear);
+    anim_start(img, (lv_anim_exec_xcb_t)lv_obj_set_y, 0, vres - h, BOUNCE_Y_TIME, 0, lv_anim_path_linear);
+
+    return 0;
+}
+
+/*The animation engine scenes. See `engine_cfg`.*/
+static uint32_t engine_1_create(lv_obj_t * scr)
+{
+    return engine_create(scr, 0);
+}
+
+static uint32_t engine_10_create(lv_obj_t * scr)
+{
+    return engine_create(scr, 1);
+}
+
+static uint32_t engine_100_create(lv_obj_t * scr)
+{
+    return engine_create(scr, 2);
+}
+
+static uint32_t engine_1000_create(lv_obj_t * scr)
+{
+    return engine_create(scr, 3);
+}
+
+static uint32_t engine_5000_create(lv_obj_t * scr)
+{
+    return engine_create(scr, 4);
+}
+
+static uint32_t engine_pos_create(lv_obj_t * scr)
+{
+    return engine_create(scr, 5);
+}
+
+static uint32_t engine_opa_create(lv_obj_t * scr)
+{
+    return engine_create(scr, 6);
+}
+
+static uint32_t engine_size_create(lv_obj_t * scr)
+{
+    return engine_create(scr, 7);
+}
+
+/**
+ * Create small objects with an animation each.
+ * Two probe animations are added before and after them. The engine runs the animations in the order of its list
+ * so the time between reaching the two probes is the time of running all the other animations in a tick.
+ * @param scr pointer to the scene's screen
+ * @param id index of the scene in `engine_cfg`
+ * @return 0: the redrawn area changes continuously
+ */
+static uint32_t engine_create(lv_obj_t * scr, uint16_t id)
+{
+    lv_coord_t hres = lv_disp_get_hor_res(NULL);
+    lv_coord_t vres = lv_disp_get_ver_res(NULL);
+    lv_coord_t x_range = LV_MATH_MAX(hres - ENGINE_OBJ_SIZE - ENGINE_MOVE, 1);
+    lv_coord_t y_range = LV_MATH_MAX(vres - ENGINE_OBJ_SIZE - ENGINE_MOVE, 1);
+
+    lv_style_copy(&style_engine, &lv_style_plain_color);
+
+    /*The previous scene's screen is deleted only after the new scene is created*/
+    if(engine_scr) engine_finish();
+
+    engine_act = id;
+    engine_scr = scr;
+    engine_res_valid[id] = true;
+    memset(&engine_res[id], 0, sizeof(benchmark_anim_tick_result_t));
+    engine_tick_sum = 0;
+    engine_tick_total = 0;
+    lv_obj_set_event_cb(scr, engine_scr_event_cb);
+    probe_seen = 0;
+
+    /*The probes are animations of the screen so they are deleted with it*/
+    anim_start(scr, probe_first_cb, 0, ENGINE_TIME, ENGINE_TIME, 0, lv_anim_path_linear);
+
+    uint16_t i;
+    for(i = 0; i < engine_cfg[id].anim_num; i++) {
+        if((i & BENCHMARK_MEM_CHECK_MASK) == 0 && benchmark_mem_is_enough(0) == false) break;
+
+        lv_coord_t x = (lv_coord_t)(((uint32_t)i * 37) % x_range);
+        lv_coord_t y = (lv_coord_t)(((uint32_t)i * 23) % y_range);
+        lv_obj_t * obj = lv_obj_create(scr, NULL);
+        lv_obj_set_style(obj, &style_engine);
+        lv_obj_set_size(obj, ENGINE_OBJ_SIZE, ENGINE_OBJ_SIZE);
+        lv_obj_set_pos(obj, x, y);
+
+        /*Different times so the objects don't move together*/
+        uint16_t time = ENGINE_TIME + (i % 7) * 100;
+        engine_prop_t prop = engine_cfg[id].prop == ENGINE_MIXED ? i % 3 : engine_cfg[id].prop;
+        switch(prop) {
+            case ENGINE_POS:
+                anim_start(obj, (lv_anim_exec_xcb_t)lv_obj_set_x, x, x + ENGINE_MOVE, time, 0, lv_anim_path_linear);
+                break;
+            case ENGINE_OPA:
+                lv_obj_set_opa_scale_enable(obj, true);
+                anim_start(obj, (lv_anim_exec_xcb_t)lv_obj_set_opa_scale, LV_OPA_TRANSP, LV_OPA_COVER, time, 0, lv_anim_path_linear);
+                break;
+            default:
+                anim_start(obj, (lv_anim_exec_xcb_t)lv_obj_set_width, ENGINE_OBJ_SIZE, ENGINE_OBJ_SIZE + ENGINE_MOVE, time, 0,
+                           lv_anim_path_linear);
+                break;
+        }
+        engine_res[id].anim_num++;
+    }
+
+    anim_start(scr, probe_last_cb, 0, ENGINE_TIME, ENGINE_TIME, 0, lv_anim_path_linear);
+
+    return 0;
+}
+
+/**
+ * Exec. callback of the probe animation created before the others
+ * @param var the scene's screen (unused)
+ * @param value the current value (unused)
+ */
+static void probe_first_cb(void * var, lv_anim_value_t value)
+{
+    (void) var;     /*Unused*/
+    (void) value;   /*Unused*/
+
+    probe_reached(0);
+}
+
+/**
+ * Exec. callback of the probe animation created after the others
+ * @param var the scene's screen (unused)
+ * @param value the current value (unused)
+ */
+static void probe_last_cb(void * var, lv_anim_value_t value)
+{
+    (void) var;     /*Unused*/
+    (void) value;   /*Unused*/
+
+    probe_reached(1);
+}
+
+/**
+ * Finish the running scene when its screen is deleted
+ * @param scr pointer to the scene's screen
+ * @param event the current event
+ */
+static void engine_scr_event_cb(lv_obj_t * scr, lv_event_t event)
+{
+    if(event == LV_EVENT_DELETE && scr == engine_scr) engine_finish();
+}
+
+/**
+ * Calculate the averages of the running scene. Its ticks are not measured anymore.
+ */
+static void engine_finish(void)
+{
+    benchmark_anim_tick_result_t * res = &engine_res[engine_act];
+    if(res->tick_cnt) {
+        res->tick_avg = (uint32_t)(engine_tick_sum / res->tick_cnt / 1000);
+        res->ns_per_anim = res->anim_num ? (uint32_t)(engine_tick_sum / res->tick_cnt / res->anim_num) : 0;
+    }
+
+    engine_scr = NULL;
+}
+
+/**
+ * Save when a probe was reached. When both are reached in a tick add the time between them.
+ * It doesn't matter which end of the animation list the engine starts from.
+ * @param probe 0: the first probe; 1: the last probe
+ */
+static void probe_reached(uint8_t probe)
+{
+    uint64_t now = benchmark_get_time_ns();
+
+    /*Reaching the same probe again means a new tick (shouldn't happen if both are running)*/
+    if(probe_seen & (1 << probe)) probe_seen = 0;
+
+    probe_time[probe] = now;
+    probe_seen |= 1 << probe;
+    if(probe_seen != 0x3) return;
+    probe_seen = 0;
+
+    /*The scene is finished, its result is calculated already*/
+    if(engine_scr == NULL) return;
+
+    benchmark_anim_tick_result_t * res = &engine_res[engine_act];
+    engine_tick_total++;
+    if(engine_tick_total <= ENGINE_WARMUP) return;
+
+    uint32_t tick = (uint32_t)(probe_time[0] > probe_time[1] ? probe_time[0] - probe_time[1] : probe_time[1] - probe_time[0]);
+    engine_tick_sum += tick;
+    if(tick / 1000 > res->tick_max) res->tick_max = tick / 1000;
+    res->tick_cnt++;
+}
+
+/**
+ * Start an animation which plays back and repeats forever.
+ * It is deleted together with its object.
+ * @param var the animated object
+ * @param exec_cb function to set the value
+ * @param start start value
+ * @param end end value
+ * @param time time of one direction in milliseconds
+ * @param delay wait before starting in milliseconds
+ * @param path_cb the animation path
+ */
+static void anim_start(void * var, lv_anim_exec_xcb_t exec_cb, lv_coord_t start, lv_coord_t end,
+                       uint16_t time, int16_t delay, lv_anim_path_cb_t path_cb)
+{
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_exec_cb(&a, var, exec_cb);
+    lv_anim_set_values(&a, start, end);
+    lv_anim_set_time(&a, time, delay);
+    lv_anim_set_path_cb(&a, path_cb);
+    lv_anim_set_playback(&a, 0);
+    lv_anim_set_repeat(&a, 0);
+    lv_anim_create(&a);
+}
+
+#endif /*LV_USE_BENCHMARK*/
@@ -0,0 +1,242 @@
+/**
+ * @file lv_benchmark_dirty.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_benchmark.h"
+#if LV_USE_BENCHMARK
+
+#include <stdio.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define DIRTY_OBJ_MAX       48
+#define CURSOR_WIDTH        (LV_DPI / 40 + 1)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static uint32_t cursor_16_create(lv_obj_t * scr);
+static uint32_t labels_8_create(lv_obj_t * scr);
+static uint32_t labels_24_create(lv_obj_t * scr);
+static uint32_t labels_48_create(lv_obj_t * scr);
+static uint32_t bars_16_create(lv_obj_t * scr);
+static uint32_t dashboard_create(lv_obj_t * scr);
+static void dirty_update(uint32_t frame);
+static void dashboard_fill(lv_obj_t * scr, uint16_t label_num, uint16_t bar_num, uint16_t cursor_num);
+static void cell_get(uint16_t id, uint16_t cnt, lv_area_t * cell);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static const benchmark_scene_t dirty_scenes[] = {
+    {"cursor_16", cursor_16_create, dirty_update},
+    {"labels_8", labels_8_create, dirty_update},
+    {"labels_24", labels_24_create, dirty_update},
+    {"labels_48", labels_48_create, dirty_update},
+    {"bars_16", bars_16_create, dirty_update},
+    {"dashboard", dashboard_create, dirty_update},
+};
+
+static lv_obj_t * labels[DIRTY_OBJ_MAX];
+static lv_obj_t * bars[DIRTY_OBJ_MAX];
+static lv_obj_t * cursors[DIRTY_OBJ_MAX];
+static uint16_t label_cnt;
+static uint16_t bar_cnt;
+static uint16_t cursor_cnt;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Get the scenes which change many small, scattered objects before every refresh
+ * (blinking cursors, clock labels, progress bars). Use them with `benchmark_start_dirty()`.
+ * @param cnt store the number of scenes here
+ * @return the array of scenes
+ */
+const benchmark_scene_t * benchmark_get_dirty_scenes(uint16_t * cnt)
+{
+    *cnt = sizeof(dirty_scenes) / sizeof(dirty_scenes[0]);
+    return dirty_scenes;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Cursors which blink on every refresh
+ * @param scr pointer to the scene's screen
+ * @return 0: not relevant
+ */
+static uint32_t cursor_16_create(lv_obj_t * scr)
+{
+    dashboard_fill(scr, 0, 0, 16);
+
+    return 0;
+}
+
+/**
+ * Clock labels updated on every refresh
+ * @param scr pointer to the scene's screen
+ * @return 0: not relevant
+ */
+static uint32_t labels_8_create(lv_obj_t * scr)
+{
+    dashboard_fill(scr, 8, 0, 0);
+
+    return 0;
+}
+
+/**
+ * Clock labels updated on every refresh
+ * @param scr pointer to the scene's screen
+ * @return 0: not relevant
+ */
+static uint32_t labels_24_create(lv_obj_t * scr)
+{
+    dashboard_fill(scr, 24, 0, 0);
+
+    return 0;
+}
+
+/**
+ * Clock labels updated on every refresh.
+ * More areas than `LV_INV_BUF_SIZE` (32 by default) so LittlevGL invalidates the whole screen instead.
+ * @param scr pointer to the scene's screen
+ * @return 0: not relevant
+ */
+static uint32_t labels_48_create(lv_obj_t * scr)
+{
+    dashboard_fill(scr, 48, 0, 0);
+
+    return 0;
+}
+
+/**
+ * Progress bars changed on every refresh
+ * @param scr pointer to the scene's screen
+ * @return 0: not relevant
+ */
+static uint32_t bars_16_create(lv_obj_t * scr)
+{
+    dashboard_fill(scr, 0, 16, 0);
+
+    return 0;
+}
+
+/**
+ * A mix of labels, bars and cursors like on a typical dashboard
+ * @param scr pointer to the scene's screen
+ * @return 0: not relevant
+ */
+static uint32_t dashboard_create(lv_obj_t * scr)
+{
+    dashboard_fill(scr, 12, 8, 4);
+
+    return 0;
+}
+
+/**
+ * Change every object of the current scene. Called before each refresh.
+ * @param frame index of the next refresh
+ */
+static void dirty_update(uint32_t frame)
+{
+    uint16_t i;
+    for(i = 0; i < label_cnt; i++) {
+        uint32_t sec = frame + i * 37;
+        char buf[16];
+        sprintf(buf, "%02d:%02d:%02d", (int)(sec / 3600) % 24, (int)(sec / 60) % 60, (int)sec % 60);
+        lv_label_set_text(labels[i], buf);
+    }
+
+    for(i = 0; i < bar_cnt; i++) {
+        lv_bar_set_value(bars[i], (frame * 3 + i * 7) % 100, LV_ANIM_OFF);
+    }
+
+    for(i = 0; i < cursor_cnt; i++) {
+        lv_obj_set_hidden(cursors[i], frame & 0x1 ? true : false);
+    }
+}
+
+/**
+ * Create labels, bars and cursors in a grid. The labels are the first, the cursors are the last.
+ * @param scr pointer to the scene's screen
+ * @param label_num number of clock labels
+ * @param bar_num number of progress bars
+ * @param cursor_num number of blinking cursors
+ */
+static void dashboard_fill(lv_obj_t * scr, uint16_t label_num, uint16_t bar_num, uint16_t cursor_num)
+{
+    uint16_t cnt = label_num + bar_num + cursor_num;
+    uint16_t id = 0;
+    lv_area_t cell;
+    uint16_t i;
+
+    label_cnt = 0;
+    bar_cnt = 0;
+    cursor_cnt = 0;
+
+    for(i = 0; i < label_num && label_cnt < DIRTY_OBJ_MAX; i++) {
+        cell_get(id++, cnt, &cell);
+        lv_obj_t * label = lv_label_create(scr, NULL);
+        lv_label_set_text(label, "00:00:00");
+        lv_obj_set_pos(label, cell.x1, cell.y1);
+        labels[label_cnt++] = label;
+    }
+
+    for(i = 0; i < bar_num && bar_cnt < DIRTY_OBJ_MAX; i++) {
+        cell_get(id++, cnt, &cell);
+        lv_obj_t * bar = lv_bar_create(scr, NULL);
+        lv_obj_set_size(bar, lv_area_get_width(&cell), lv_area_get_height(&cell) / 3);
+        lv_obj_set_pos(bar, cell.x1, cell.y1);
+        bars[bar_cnt++] = bar;
+    }
+
+    for(i = 0; i < cursor_num && cursor_cnt < DIRTY_OBJ_MAX; i++) {
+        cell_get(id++, cnt, &cell);
+        lv_obj_t * cursor = lv_obj_create(scr, NULL);
+        lv_obj_set_style(cursor, &lv_style_plain_color);
+        lv_obj_set_size(cursor, CURSOR_WIDTH, lv_area_get_height(&cell) / 2);
+        lv_obj_set_pos(cursor, cell.x1, cell.y1);
+        cursors[cursor_cnt++] = cursor;
+    }
+}
+
+/**
+ * Get the area of a cell in a grid which spreads the objects on the whole screen
+ * @param id index of the object
+ * @param cnt number of objects
+ * @param cell store the area of the cell here. Margins are already subtracted.
+ */
+static void cell_get(uint16_t id, uint16_t cnt, lv_area_t * cell)
+{
+    lv_coord_t hres = lv_disp_get_hor_res(NULL);
+    lv_coord_t vres = lv_disp_get_ver_res(NULL);
+    uint16_t col_num = cnt <= 16 ? 4 : 8;
+    uint16_t row_num = (cnt + col_num - 1) / col_num;
+    lv_coord_t cell_w = hres / col_num;
+    lv_coord_t cell_h = vres / row_num;
+    lv_coord_t margin = cell_w / 10;
+
+    cell->x1 = (id % col_num) * cell_w + margin;
+    cell->y1 = (id / col_num) * cell_h + margin;
+    cell->x2 = cell->x1 + cell_w - 2 * margin - 1;
+    cell->y2 = cell->y1 + cell_h - 2 * margin - 1;
+}
+
+#endif /*LV_USE_BENCHMARK*/
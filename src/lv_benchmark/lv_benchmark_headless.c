@@ -0,0 +1,1486 @@
+/**
+ * @file lv_benchmark_headless.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_benchmark_headless.h"
+#if LV_USE_BENCHMARK && LV_USE_BENCHMARK_HEADLESS
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#include <pthread.h>
+
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+#define RES_ENTRY_MAX   (BENCHMARK_SCENE_MAX * BENCHMARK_HEADLESS_BUF_SWEEP_NUM + 1)  /*The buffer sweep has the most*/
+#define NOISE_FACTOR    2   /*Slow down smaller than this many standard errors is considered as noise*/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*The matrix measured on a resolution of the sweep*/
+typedef struct {
+    lv_coord_t hres;
+    lv_coord_t vres;
+    benchmark_result_t res[BENCHMARK_STYLE_NUM];
+    char scene[32];             /*"holder_page_<hres>x<vres>"*/
+} sweep_entry_t;
+
+/*The scenes measured with a draw buffer configuration*/
+typedef struct {
+    uint8_t div;                /*A buffer is 1/div of the screen*/
+    bool dbl;
+    uint32_t ram;               /*Size of the buffers in bytes*/
+    uint16_t scene_cnt;
+    benchmark_result_t res[BENCHMARK_SCENE_MAX];
+    const char * names[BENCHMARK_SCENE_MAX];
+    char config[32];            /*"div<div>_single" or "div<div>_double"*/
+} buf_entry_t;
+
+/*A measured test in the output*/
+typedef struct {
+    char scene[32];
+    char config[32];
+    const benchmark_result_t * res;
+    bool has_cost;          /*true: it's a primitive scene with cost per 1000 pixels*/
+    uint32_t ns_per_kpx;
+    const benchmark_dirty_result_t * dirty;     /*Not NULL: it's a scene with small invalidations*/
+    const benchmark_text_result_t * text;       /*Not NULL: it's a text scene*/
+    const benchmark_img_result_t * img;         /*Not NULL: it's an image source scene*/
+} res_entry_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void mem_flush(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p);
+static void dma_flush(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p);
+static void * dma_thread(void * param);
+static void buf_free(void);
+static void dma_stop(void);
+static void fb_copy(lv_coord_t hres, const lv_area_t * area, const lv_color_t * color_p);
+static void trace_store(const benchmark_trace_event_t * e);
+static void trace_ts(FILE * f, uint64_t t);
+static uint16_t res_collect(void);
+static void res_add(const char * scene, const char * config, const benchmark_result_t * res);
+static void write_result(FILE * f, const res_entry_t * e, bool last);
+static void write_sweep(FILE * f);
+static void write_buf_sweep(FILE * f);
+static char * file_read(const char * path);
+static const char * json_find(const char * obj, const char * obj_end, const char * key);
+static const char * json_find_result(const char * txt, const char * scene, const char * config, const char ** obj_end);
+static bool json_get_str(const char * obj, const char * obj_end, const char * key, char * buf, size_t buf_size);
+static bool json_get_uint(const char * obj, const char * obj_end, const char * key, uint32_t * v);
+#ifdef __linux__
+static int perf_open(uint32_t type, uint64_t config);
+#endif
+#if BENCHMARK_HEADLESS_MEM_WRAP
+static void mem_alloc_add(uint32_t size);
+void * __real_lv_mem_alloc(size_t size);
+void __real_lv_mem_free(const void * data);
+void * __real_lv_mem_realloc(void * data_p, size_t new_size);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_disp_drv_t disp_drv;
+static lv_disp_buf_t disp_buf;
+static lv_color_t * draw_buf;
+static lv_color_t * draw_buf2;
+static lv_color_t * fb;         /*Imitates the panel's own memory*/
+static uint8_t buf_div = BENCHMARK_HEADLESS_BUF_DIV;
+static bool buf_dbl;
+static uint32_t flush_ns_per_px;
+
+/*The emulated DMA: `dma_flush` gives the area to `dma_thread` which "sends" it*/
+static pthread_t dma_tid;
+static pthread_mutex_t dma_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t dma_cond = PTHREAD_COND_INITIALIZER;
+static bool dma_run;
+static bool dma_pending;
+static lv_area_t dma_area;
+static const lv_color_t * dma_color_p;
+static res_entry_t res_entries[RES_ENTRY_MAX];
+static uint16_t res_entry_cnt;
+#ifdef __linux__
+static int cnt_fd[BENCHMARK_CNT_NUM] = {-1, -1, -1, -1};
+#endif
+static const char * cnt_names[BENCHMARK_CNT_NUM] = {"instructions", "cycles", "cache_misses", "branch_misses"};
+static sweep_entry_t sweep_entries[BENCHMARK_HEADLESS_SWEEP_MAX];
+static uint16_t sweep_cnt;
+static const lv_coord_t sweep_def_res[] = {320, 240, 480, 272, 800, 480, 1024, 600, 1280, 720};
+static buf_entry_t buf_entries[BENCHMARK_HEADLESS_BUF_SWEEP_NUM];
+static uint16_t buf_cnt;
+static benchmark_trace_event_t * trace_buf;
+static uint32_t trace_cnt;
+static uint32_t trace_lost;         /*Events dropped because `trace_buf` was full*/
+static uint64_t trace_begin;        /*Clock value of the trace's zero*/
+static uint32_t mem_alloc_cnt;
+static uint32_t mem_free_cnt;
+static uint32_t mem_alloc_size;         /*Currently allocated bytes (without the block headers)*/
+static uint32_t mem_alloc_max;          /*The most allocated bytes since the last reset*/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Create a display which renders into RAM only and make it the default display.
+ * Only one headless display can exist at a time.
+ * @param hres horizontal resolution
+ * @param vres vertical resolution
+ * @return pointer to the created display or NULL if there was not enough memory
+ */
+lv_disp_t * benchmark_headless_disp_create(lv_coord_t hres, lv_coord_t vres)
+{
+    uint32_t buf_size = ((uint32_t)hres * vres) / buf_div;
+
+    draw_buf = malloc(buf_size * sizeof(lv_color_t));
+    draw_buf2 = buf_dbl ? malloc(buf_size * sizeof(lv_color_t)) : NULL;
+    fb = malloc((uint32_t)hres * vres * sizeof(lv_color_t));
+
+    if(draw_buf == NULL || (buf_dbl && draw_buf2 == NULL) || fb == NULL) {
+        buf_free();
+        return NULL;
+    }
+
+    /*Start the DMA only with the buffers ready*/
+    dma_run = false;
+    dma_pending = false;
+    if(flush_ns_per_px) {
+        dma_run = true;
+        if(pthread_create(&dma_tid, NULL, dma_thread, NULL) != 0) {
+            dma_run = false;
+            buf_free();
+            return NULL;
+        }
+    }
+
+    lv_disp_buf_init(&disp_buf, draw_buf, draw_buf2, buf_size);
+
+    lv_disp_drv_init(&disp_drv);
+    disp_drv.hor_res = hres;
+    disp_drv.ver_res = vres;
+    disp_drv.buffer = &disp_buf;
+    disp_drv.flush_cb = dma_run ? dma_flush : mem_flush;
+
+    lv_disp_t * disp = lv_disp_drv_register(&disp_drv);
+    if(disp == NULL) {
+        dma_stop();
+        buf_free();
+        return NULL;
+    }
+
+    lv_disp_set_default(disp);
+
+    return disp;
+}
+
+/**
+ * Delete the headless display and free its buffers
+ * @param disp pointer to a display created by `benchmark_headless_disp_create`
+ */
+void benchmark_headless_disp_del(lv_disp_t * disp)
+{
+    /*`lv_disp_remove` leaves the screens and the refresh task*/
+    lv_obj_t * scr;
+    while((scr = lv_ll_get_head(&disp->scr_ll)) != NULL) lv_obj_del(scr);
+    lv_task_del(disp->refr_task);
+    disp->refr_task = NULL;
+
+    lv_disp_remove(disp);
+
+    dma_stop();
+    buf_free();
+}
+
+/**
+ * Set the draw buffers of the next `benchmark_headless_disp_create()`
+ * @param div the size of a buffer is 1/`div` of the screen (e.g. 10, 4, 2, 1)
+ * @param dbl true: use two buffers so rendering continues while the other buffer is flushed
+ */
+void benchmark_headless_set_buf(uint8_t div, bool dbl)
+{
+    if(div == 0) div = 1;
+
+    buf_div = div;
+    buf_dbl = dbl;
+}
+
+/**
+ * Emulate a panel which receives the pixels in the background (e.g. SPI with DMA)
+ * so the flush takes time but doesn't block the CPU. Applies from the next `benchmark_headless_disp_create()`.
+ * Without it the flush is a `memcpy` which is ready immediately so double buffering doesn't matter.
+ * @param ns_per_px transfer time of a pixel in nanoseconds (e.g. 400 for 16 bit pixels on a 40 MHz SPI) or 0 to not emulate
+ */
+void benchmark_headless_set_flush_time(uint32_t ns_per_px)
+{
+    flush_ns_per_px = ns_per_px;
+}
+
+/**
+ * Get the elapsed milliseconds from the host's monotonic clock.
+ * Use it as `LV_TICK_CUSTOM_SYS_TIME_EXPR` so no tick interrupt is required.
+ * @return milliseconds since the first call
+ */
+uint32_t benchmark_headless_tick_get(void)
+{
+    static uint64_t start_ms = 0;
+
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    uint64_t now_ms = (uint64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+
+    if(start_ms == 0) start_ms = now_ms;
+
+    return (uint32_t)(now_ms - start_ms);
+}
+
+/**
+ * Get the time from the host's monotonic clock in nanoseconds.
+ * Pass it to `benchmark_set_clock_cb()` to measure the refreshes with sub-millisecond resolution.
+ * @return nanoseconds since an arbitrary point
+ */
+uint64_t benchmark_headless_clock_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/**
+ * Open the hardware performance counters of this thread with `perf_event_open`.
+ * Pass `benchmark_headless_cnt_read` to `benchmark_set_cnt_cb()` to use them.
+ * The counters which are not supported (not Linux, no permission, virtual machine etc.) are skipped.
+ * @return number of opened counters
+ */
+uint8_t benchmark_headless_cnt_open(void)
+{
+    uint8_t cnt = 0;
+#ifdef __linux__
+    static const uint64_t configs[BENCHMARK_CNT_NUM] = {
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_CACHE_MISSES,
+        PERF_COUNT_HW_BRANCH_MISSES
+    };
+
+    uint8_t i;
+    for(i = 0; i < BENCHMARK_CNT_NUM; i++) {
+        if(cnt_fd[i] < 0) cnt_fd[i] = perf_open(PERF_TYPE_HARDWARE, configs[i]);
+        if(cnt_fd[i] >= 0) cnt++;
+    }
+#endif
+
+    return cnt;
+}
+
+/**
+ * Close the counters opened by `benchmark_headless_cnt_open()`
+ */
+void benchmark_headless_cnt_close(void)
+{
+#ifdef __linux__
+    uint8_t i;
+    for(i = 0; i < BENCHMARK_CNT_NUM; i++) {
+        if(cnt_fd[i] >= 0) close(cnt_fd[i]);
+        cnt_fd[i] = -1;
+    }
+#endif
+}
+
+/**
+ * Tell whether a hardware counter could be opened
+ * @param id a `BENCHMARK_CNT_...` value
+ * @return true: the counter is available
+ */
+bool benchmark_headless_cnt_is_avail(uint8_t id)
+{
+#ifdef __linux__
+    if(id < BENCHMARK_CNT_NUM && cnt_fd[id] >= 0) return true;
+#else
+    (void) id; /*Unused*/
+#endif
+
+    return false;
+}
+
+/**
+ * Read the current value of the hardware counters. The not available ones are 0.
+ * If the kernel shares a counter with other events (multiplexing) its value is scaled up to the whole time.
+ * @param values store the `BENCHMARK_CNT_NUM` values here
+ */
+void benchmark_headless_cnt_read(uint64_t * values)
+{
+    uint8_t i;
+    for(i = 0; i < BENCHMARK_CNT_NUM; i++) {
+        values[i] = 0;
+#ifdef __linux__
+        if(cnt_fd[i] < 0) continue;
+
+        /*value, time enabled, time running*/
+        uint64_t buf[3];
+        if(read(cnt_fd[i], buf, sizeof(buf)) != sizeof(buf)) continue;
+
+        if(buf[2] == 0) continue;
+        else if(buf[2] < buf[1]) values[i] = (uint64_t)((double)buf[0] * buf[1] / buf[2]);
+        else values[i] = buf[0];
+#endif
+    }
+}
+
+/**
+ * Read the number of `lv_mem` allocations and frees since the start.
+ * Pass it to `benchmark_set_mem_cnt_cb()`. Counts only with `BENCHMARK_HEADLESS_MEM_WRAP`, else both are 0.
+ * @param alloc_cnt store the number of allocations here (a reallocation which moves the data counts as an allocation and a free)
+ * @param free_cnt store the number of frees here
+ */
+void benchmark_headless_mem_cnt_read(uint32_t * alloc_cnt, uint32_t * free_cnt)
+{
+    *alloc_cnt = mem_alloc_cnt;
+    *free_cnt = mem_free_cnt;
+}
+
+/**
+ * Read the most bytes allocated with `lv_mem` at once.
+ * Pass it to `benchmark_set_mem_peak_cb()`. Follows the allocations only with `BENCHMARK_HEADLESS_MEM_WRAP`, else returns 0.
+ * @param reset true: restart from the currently allocated bytes
+ * @return the peak of the allocated bytes since the last reset
+ */
+uint32_t benchmark_headless_mem_peak_read(bool reset)
+{
+    if(reset) mem_alloc_max = mem_alloc_size;
+    return mem_alloc_max;
+}
+
+#if BENCHMARK_HEADLESS_MEM_WRAP
+/*The linker redirects the calls of `lv_mem_alloc/free/realloc` here (`--wrap`).
+ *The calls inside `lv_mem.c` are not redirected so a reallocation is counted only once.*/
+
+void * __wrap_lv_mem_alloc(size_t size)
+{
+    mem_alloc_cnt++;
+    void * p = __real_lv_mem_alloc(size);
+    if(p) mem_alloc_add(lv_mem_get_size(p));
+    return p;
+}
+
+void __wrap_lv_mem_free(const void * data)
+{
+    if(data) {
+        mem_free_cnt++;
+        mem_alloc_size -= lv_mem_get_size(data);
+    }
+    __real_lv_mem_free(data);
+}
+
+void * __wrap_lv_mem_realloc(void * data_p, size_t new_size)
+{
+    uint32_t old_size = data_p ? lv_mem_get_size(data_p) : 0;
+    void * p = __real_lv_mem_realloc(data_p, new_size);
+    if(p == NULL) return NULL;      /*`data_p` is kept*/
+
+    /*The same size is returned as it is and shrinking truncates in place*/
+    if(p != data_p) {
+        if(data_p) mem_free_cnt++;
+        if(new_size) mem_alloc_cnt++;
+    }
+
+    mem_alloc_size -= old_size;
+    mem_alloc_add(lv_mem_get_size(p));
+    return p;
+}
+#endif
+
+/**
+ * Call `lv_task_handler()` in a loop until the started benchmark is ready
+ * @param timeout_ms give up after this many milliseconds
+ * @return true: the benchmark finished; false: timeout
+ */
+bool benchmark_headless_run(uint32_t timeout_ms)
+{
+    uint32_t start = lv_tick_get();
+
+    while(benchmark_is_ready() == false) {
+        if(lv_tick_elaps(start) > timeout_ms) return false;
+        lv_task_handler();
+    }
+
+    return true;
+}
+
+/**
+ * Run the style matrix on displays with different resolutions one after the other.
+ * For each resolution a new headless display and benchmark is created and deleted when the matrix is finished.
+ * The results are written by `benchmark_headless_write_json()` with the resolution in the scene's name
+ * and a `sweep` list which compares the time per pixel of the resolutions.
+ * @param res_list pairs of horizontal and vertical resolutions (e.g. `{320, 240, 480, 272}`)
+ *                 or NULL to use 320x240, 480x272, 800x480, 1024x600 and 1280x720
+ * @param cnt number of resolutions in `res_list`. Limited to `BENCHMARK_HEADLESS_SWEEP_MAX`.
+ * @param timeout_ms give up a resolution after this many milliseconds
+ * @return number of measured resolutions. Stops at the first one which couldn't be created or timed out.
+ */
+uint16_t benchmark_headless_sweep(const lv_coord_t * res_list, uint16_t cnt, uint32_t timeout_ms)
+{
+    if(res_list == NULL) {
+        res_list = sweep_def_res;
+        cnt = sizeof(sweep_def_res) / sizeof(sweep_def_res[0]) / 2;
+    }
+    if(cnt > BENCHMARK_HEADLESS_SWEEP_MAX) cnt = BENCHMARK_HEADLESS_SWEEP_MAX;
+
+    sweep_cnt = 0;
+
+    uint16_t i;
+    for(i = 0; i < cnt; i++) {
+        lv_coord_t hres = res_list[i * 2];
+        lv_coord_t vres = res_list[i * 2 + 1];
+        if(hres > LV_HOR_RES_MAX || vres > LV_VER_RES_MAX) break;
+
+        lv_disp_t * disp = benchmark_headless_disp_create(hres, vres);
+        if(disp == NULL) break;
+
+        /*The benchmark sizes its page from the default display so create it again on each*/
+        benchmark_create();
+        benchmark_start_matrix();
+        bool ready = benchmark_headless_run(timeout_ms);
+
+        if(ready) {
+            sweep_entry_t * e = &sweep_entries[sweep_cnt];
+            e->hres = hres;
+            e->vres = vres;
+            sprintf(e->scene, "holder_page_%dx%d", hres, vres);
+
+            uint8_t s;
+            for(s = 0; s < BENCHMARK_STYLE_NUM; s++) e->res[s] = *benchmark_get_matrix_result(s);
+            sweep_cnt++;
+        }
+
+        benchmark_headless_disp_del(disp);
+        if(ready == false) break;
+    }
+
+    return sweep_cnt;
+}
+
+/**
+ * Measure the drawing primitive scenes with 1/10, 1/4, 1/2 and full screen sized draw buffers,
+ * with one and two buffers each. For each configuration a new headless display and benchmark is created.
+ * The results are written by `benchmark_headless_write_json()` with the buffer configuration as `config`
+ * and a `buffers` list with the RAM of the buffers and the average frame time of the scenes.
+ * A configuration is skipped if its buffers can't be allocated.
+ * @param hres horizontal resolution
+ * @param vres vertical resolution
+ * @param timeout_ms give up a configuration after this many milliseconds
+ * @return number of measured configurations. Stops at the first one which timed out.
+ */
+uint16_t benchmark_headless_buf_sweep(lv_coord_t hres, lv_coord_t vres, uint32_t timeout_ms)
+{
+    static const uint8_t divs[] = {10, 4, 2, 1};
+    uint8_t div_saved = buf_div;
+    bool dbl_saved = buf_dbl;
+
+    buf_cnt = 0;
+
+    uint8_t d;
+    for(d = 0; d < sizeof(divs); d++) {
+        uint8_t b;
+        for(b = 0; b < 2; b++) {
+            benchmark_headless_set_buf(divs[d], b ? true : false);
+            lv_disp_t * disp = benchmark_headless_disp_create(hres, vres);
+            if(disp == NULL) continue;
+
+            benchmark_create();
+            uint16_t cnt;
+            const benchmark_scene_t * prim = benchmark_get_prim_scenes(&cnt);
+            benchmark_start_scenes(prim, cnt);
+            bool ready = benchmark_headless_run(timeout_ms);
+
+            if(ready) {
+                buf_entry_t * e = &buf_entries[buf_cnt];
+                e->div = buf_div;
+                e->dbl = buf_dbl;
+                e->ram = disp_buf.size * sizeof(lv_color_t) * (buf_dbl ? 2 : 1);
+                e->scene_cnt = benchmark_get_scene_cnt();
+                sprintf(e->config, "div%d_%s", buf_div, buf_dbl ? "double" : "single");
+
+                uint16_t i;
+                for(i = 0; i < e->scene_cnt; i++) {
+                    e->res[i] = *benchmark_get_scene_result(i);
+                    e->names[i] = benchmark_get_scene_name(i);
+                }
+                buf_cnt++;
+            }
+
+            benchmark_headless_disp_del(disp);
+            if(ready == false) {
+                benchmark_headless_set_buf(div_saved, dbl_saved);
+                return buf_cnt;
+            }
+        }
+    }
+
+    benchmark_headless_set_buf(div_saved, dbl_saved);
+
+    return buf_cnt;
+}
+
+/**
+ * Write the result of the last benchmark run as JSON
+ * @param f the output stream
+ */
+void benchmark_headless_write_json(FILE * f)
+{
+    fprintf(f, "{\n");
+    fprintf(f, "  \"lvgl\": \"%d.%d.%d\",\n", LVGL_VERSION_MAJOR, LVGL_VERSION_MINOR, LVGL_VERSION_PATCH);
+    fprintf(f, "  \"color_depth\": %d,\n", LV_COLOR_DEPTH);
+    fprintf(f, "  \"antialias\": %d,\n", LV_ANTIALIAS);
+    if(lv_disp_get_default()) {
+        fprintf(f, "  \"hor_res\": %d,\n", lv_disp_get_hor_res(NULL));
+        fprintf(f, "  \"ver_res\": %d,\n", lv_disp_get_ver_res(NULL));
+    }
+
+    fprintf(f, "  \"hw_counters\": [");
+    bool first = true;
+    uint8_t c;
+    for(c = 0; c < BENCHMARK_CNT_NUM; c++) {
+        if(benchmark_headless_cnt_is_avail(c) == false) continue;
+        fprintf(f, "%s\"%s\"", first ? "" : ", ", cnt_names[c]);
+        first = false;
+    }
+    fprintf(f, "],\n");
+    fprintf(f, "  \"results\": [\n");
+
+    uint16_t cnt = res_collect();
+    uint16_t i;
+    for(i = 0; i < cnt; i++) {
+        write_result(f, &res_entries[i], i == cnt - 1);
+    }
+
+    fprintf(f, "  ]");
+
+    if(sweep_cnt) write_sweep(f);
+    if(buf_cnt) write_buf_sweep(f);
+
+    if(benchmark_get_obj_cnt()) {
+        fprintf(f, ",\n  \"objects\": [\n");
+        for(i = 0; i < benchmark_get_obj_cnt(); i++) {
+            const benchmark_obj_result_t * ores = benchmark_get_obj_result(i);
+            fprintf(f, "    {\"obj_num\": %u", (unsigned int)ores->obj_num);
+            if(ores->skipped) {
+                fprintf(f, ", \"skipped\": true");
+            } else {
+                fprintf(f, ", \"create_us\": %u, \"render_us\": %u, \"del_us\": %u, "
+                        "\"mem_used\": %u, \"mem_per_obj\": %u, \"mem_leak\": %u, \"frag_pct\": %u",
+                        (unsigned int)ores->create_time, (unsigned int)ores->render_time, (unsigned int)ores->del_time,
+                        (unsigned int)ores->mem_used, (unsigned int)ores->mem_per_obj, (unsigned int)ores->mem_leak,
+                        (unsigned int)ores->frag_pct);
+            }
+            fprintf(f, "}%s\n", i == benchmark_get_obj_cnt() - 1 ? "" : ",");
+        }
+        fprintf(f, "  ]");
+    }
+
+    if(benchmark_get_layout_cnt()) {
+        fprintf(f, ",\n  \"layouts\": [\n");
+        for(i = 0; i < benchmark_get_layout_cnt(); i++) {
+            const benchmark_layout_result_t * lres = benchmark_get_layout_result(i);
+            fprintf(f, "    {\"obj_num\": %u", (unsigned int)lres->obj_num);
+            if(lres->skipped) {
+                fprintf(f, ", \"skipped\": true");
+            } else {
+                fprintf(f, ", \"build_us\": %u, \"layout_us\": %u, \"fit_us\": %u, \"resize_us\": %u, "
+                        "\"add_us\": %u, \"del_us\": %u, \"draw_us\": %u",
+                        (unsigned int)lres->build_time, (unsigned int)lres->layout_time, (unsigned int)lres->fit_time,
+                        (unsigned int)lres->resize_time, (unsigned int)lres->add_time, (unsigned int)lres->del_time,
+                        (unsigned int)lres->draw_time);
+            }
+            fprintf(f, "}%s\n", i == benchmark_get_layout_cnt() - 1 ? "" : ",");
+        }
+        fprintf(f, "  ]");
+    }
+
+    if(benchmark_get_style_mod_cnt()) {
+        fprintf(f, ",\n  \"style_mods\": [\n");
+        for(i = 0; i < benchmark_get_style_mod_cnt(); i++) {
+            const benchmark_style_mod_result_t * sres = benchmark_get_style_mod_result(i);
+            fprintf(f, "    {\"obj_num\": %u", (unsigned int)sres->obj_num);
+            if(sres->skipped) {
+                fprintf(f, ", \"skipped\": true");
+            } else {
+                fprintf(f, ", \"walk_us\": %u, \"propagate_us\": %u, \"draw_us\": %u",
+                        (unsigned int)sres->walk_time, (unsigned int)sres->propagate_time, (unsigned int)sres->draw_time);
+            }
+            fprintf(f, "}%s\n", i == benchmark_get_style_mod_cnt() - 1 ? "" : ",");
+        }
+        fprintf(f, "  ]");
+    }
+
+    if(benchmark_get_task_cnt()) {
+        fprintf(f, ",\n  \"tasks\": [\n");
+        for(i = 0; i < benchmark_get_task_cnt(); i++) {
+            const benchmark_task_result_t * tres = benchmark_get_task_result(i);
+            fprintf(f, "    {\"task_num\": %u", (unsigned int)tres->task_num);
+            if(tres->skipped) {
+                fprintf(f, ", \"skipped\": true");
+            } else {
+                fprintf(f, ", \"calls\": %u, \"call_avg_us\": %u, \"call_max_us\": %u, \"ns_per_task\": %u, "
+                        "\"runs\": %u, \"late_avg_us\": %u, \"late_max_us\": %u, \"jitter_us\": %u, "
+                        "\"idle_true_pct\": %u, \"idle_reported_pct\": %u",
+                        (unsigned int)tres->call_cnt, (unsigned int)tres->call_avg, (unsigned int)tres->call_max,
+                        (unsigned int)tres->ns_per_task, (unsigned int)tres->run_cnt, (unsigned int)tres->late_avg,
+                        (unsigned int)tres->late_max, (unsigned int)tres->jitter,
+                        (unsigned int)tres->idle_true, (unsigned int)tres->idle_reported);
+            }
+            fprintf(f, "}%s\n", i == benchmark_get_task_cnt() - 1 ? "" : ",");
+        }
+        fprintf(f, "  ]");
+    }
+
+    if(benchmark_get_anim_cnt()) {
+        fprintf(f, ",\n  \"animations\": [\n");
+        for(i = 0; i < benchmark_get_anim_cnt(); i++) {
+            const benchmark_anim_result_t * ares = benchmark_get_anim_result(i);
+            fprintf(f, "    {\"scene\": \"%s\", \"duration_ms\": %u, \"frames\": %u, \"fps\": %u.%u, "
+                    "\"period_avg_us\": %u, \"period_max_us\": %u, \"jitter_us\": %u, \"dropped\": %u, "
+                    "\"refr_avg_us\": %u, \"refr_max_us\": %u, \"px_per_frame\": %u",
+                    benchmark_get_anim_name(i), (unsigned int)(ares->duration / 1000), (unsigned int)ares->frame_cnt,
+                    (unsigned int)(ares->fps_x10 / 10), (unsigned int)(ares->fps_x10 % 10),
+                    (unsigned int)ares->period_avg, (unsigned int)ares->period_max, (unsigned int)ares->jitter,
+                    (unsigned int)ares->dropped, (unsigned int)ares->refr_avg, (unsigned int)ares->refr_max,
+                    (unsigned int)ares->px_per_frame);
+
+            /*The animation engine scenes tell the time of the animation ticks too*/
+            const benchmark_anim_tick_result_t * tres = benchmark_get_anim_tick_result(benchmark_get_anim_name(i));
+            if(tres) {
+                fprintf(f, ", \"anim_num\": %u, \"ticks\": %u, \"tick_avg_us\": %u, \"tick_max_us\": %u, \"ns_per_anim\": %u",
+                        (unsigned int)tres->anim_num, (unsigned int)tres->tick_cnt, (unsigned int)tres->tick_avg,
+                        (unsigned int)tres->tick_max, (unsigned int)tres->ns_per_anim);
+            }
+            fprintf(f, "}%s\n", i == benchmark_get_anim_cnt() - 1 ? "" : ",");
+        }
+        fprintf(f, "  ]");
+    }
+
+    if(benchmark_get_latency_result(false)) {
+        fprintf(f, ",\n  \"latency\": [\n");
+        uint8_t l;
+        for(l = 0; l < 2; l++) {
+            const benchmark_latency_result_t * lres = benchmark_get_latency_result(l ? true : false);
+            fprintf(f, "    {\"load\": %s, \"events\": %u, \"avg_us\": %u, \"min_us\": %u, \"max_us\": %u, "
+                    "\"p50_us\": %u, \"p95_us\": %u, \"p99_us\": %u, \"std_dev_us\": %u, \"input_us\": %u, \"refr_us\": %u}%s\n",
+                    l ? "true" : "false", (unsigned int)lres->latency.sample_cnt, (unsigned int)lres->latency.avg,
+                    (unsigned int)lres->latency.min, (unsigned int)lres->latency.max, (unsigned int)lres->latency.p50,
+                    (unsigned int)lres->latency.p95, (unsigned int)lres->latency.p99, (unsigned int)lres->latency.std_dev,
+                    (unsigned int)lres->input_avg, (unsigned int)lres->refr_avg, l == 1 ? "" : ",");
+        }
+        fprintf(f, "  ]");
+    }
+
+    if(benchmark_matrix_is_valid()) {
+        fprintf(f, ",\n  \"feature_cost_us\": {\"wp\": %d, \"recolor\": %d, \"shadow\": %d, \"opa\": %d}",
+                (int)benchmark_get_feature_cost(BENCHMARK_STYLE_WP),
+                (int)benchmark_get_feature_cost(BENCHMARK_STYLE_RECOLOR),
+                (int)benchmark_get_feature_cost(BENCHMARK_STYLE_SHADOW),
+                (int)benchmark_get_feature_cost(BENCHMARK_STYLE_OPA));
+    }
+
+    fprintf(f, "\n}\n");
+}
+
+/**
+ * Compare the results of the last run with a baseline written earlier by `benchmark_headless_write_json()`.
+ * A test is slower if its average time grew by more than `threshold_pct` percent
+ * and by more than the measurement noise (`NOISE_FACTOR` times the standard error of the difference).
+ * @param baseline_path path to the baseline JSON file
+ * @param threshold_pct the smallest slow down in percent to report
+ * @param report the difference of each test is written here
+ * @return number of slower tests or -1 if the baseline couldn't be read
+ */
+int32_t benchmark_headless_compare(const char * baseline_path, uint32_t threshold_pct, FILE * report)
+{
+    char * base_txt = file_read(baseline_path);
+    if(base_txt == NULL) return -1;
+
+    if(strstr(base_txt, "\"results\"") == NULL) {
+        free(base_txt);
+        return -1;
+    }
+
+    int32_t slower_cnt = 0;
+    uint16_t cnt = res_collect();
+    uint16_t i;
+    for(i = 0; i < cnt; i++) {
+        const res_entry_t * e = &res_entries[i];
+
+        /*Find the same scene and config in the baseline*/
+        bool found = false;
+        uint32_t b_avg = 0;
+        uint32_t b_sd = 0;
+        uint32_t b_n = 1;
+        const char * obj_end;
+        const char * obj = json_find_result(base_txt, e->scene, e->config, &obj_end);
+        if(obj) {
+            found = json_get_uint(obj, obj_end, "avg_us", &b_avg);
+            json_get_uint(obj, obj_end, "std_dev_us", &b_sd);
+            json_get_uint(obj, obj_end, "samples", &b_n);
+            if(b_n == 0) b_n = 1;
+        }
+
+        if(found == false) {
+            fprintf(report, "%-16s %-24s %11s -> %8u us  new\n", e->scene, e->config, "-", (unsigned int)e->res->avg);
+            continue;
+        }
+
+        double diff = (double)e->res->avg - b_avg;
+        double diff_pct = b_avg ? diff * 100.0 / b_avg : 0.0;
+        double std_err = sqrt((double)b_sd * b_sd / b_n + (double)e->res->std_dev * e->res->std_dev / e->res->sample_cnt);
+
+        /*Times are integer so a difference below 1 is never significant*/
+        double noise = NOISE_FACTOR * std_err;
+        if(noise < 1.0) noise = 1.0;
+
+        const char * verdict = "ok";
+        if(diff > noise && diff_pct > threshold_pct) {
+            verdict = "SLOWER";
+            slower_cnt++;
+        } else if(-diff > noise && -diff_pct > threshold_pct) {
+            verdict = "faster";
+        }
+
+        fprintf(report, "%-16s %-24s %8u us -> %8u us  %+6.1f%%  %s\n",
+                e->scene, e->config, (unsigned int)b_avg, (unsigned int)e->res->avg, diff_pct, verdict);
+    }
+
+    free(base_txt);
+
+    return slower_cnt;
+}
+
+/**
+ * Print the average times of result files side by side as a Markdown table, e.g. to compare builds
+ * with different `LV_COLOR_DEPTH` and `LV_ANTIALIAS`. The tests of the first file are the rows,
+ * the other files are compared to it.
+ * @param paths paths to JSON files written by `benchmark_headless_write_json()`
+ * @param cnt number of files
+ * @param out the table is written here
+ * @return number of rows or -1 if a file couldn't be read
+ */
+int32_t benchmark_headless_table(const char * const * paths, uint16_t cnt, FILE * out)
+{
+    if(cnt == 0) return -1;
+
+    char ** txts = calloc(cnt, sizeof(char *));
+    if(txts == NULL) return -1;
+
+    uint16_t f;
+    for(f = 0; f < cnt; f++) {
+        txts[f] = file_read(paths[f]);
+        if(txts[f] == NULL || strstr(txts[f], "\"results\"") == NULL) {
+            for(f = 0; f < cnt; f++) free(txts[f]);
+            free(txts);
+            return -1;
+        }
+    }
+
+    /*Header: the configuration of each file*/
+    fprintf(out, "| scene | config |");
+    for(f = 0; f < cnt; f++) {
+        const char * end = txts[f] + strlen(txts[f]);
+        uint32_t depth = 0;
+        uint32_t aa = 0;
+        json_get_uint(txts[f], end, "color_depth", &depth);
+        json_get_uint(txts[f], end, "antialias", &aa);
+        fprintf(out, " %u bit%s |", (unsigned int)depth, aa ? " AA" : "");
+    }
+    fprintf(out, "\n|---|---|");
+    for(f = 0; f < cnt; f++) fprintf(out, "---:|");
+    fprintf(out, "\n");
+
+    /*Rows: the tests of the first file*/
+    int32_t row_cnt = 0;
+    const char * res = strstr(txts[0], "\"results\"");
+    const char * res_end = strchr(res, ']');
+    const char * obj = strchr(res, '{');
+    while(obj && res_end && obj < res_end) {
+        const char * obj_end = strchr(obj, '}');
+        if(obj_end == NULL) break;
+
+        char scene[32];
+        char config[32];
+        uint32_t first_avg = 0;
+        if(json_get_str(obj, obj_end, "scene", scene, sizeof(scene)) &&
+           json_get_str(obj, obj_end, "config", config, sizeof(config)) &&
+           json_get_uint(obj, obj_end, "avg_us", &first_avg)) {
+            fprintf(out, "| %s | %s | %u us |", scene, config, (unsigned int)first_avg);
+            for(f = 1; f < cnt; f++) {
+                const char * o_end;
+                const char * o = json_find_result(txts[f], scene, config, &o_end);
+                uint32_t avg;
+                if(o == NULL || json_get_uint(o, o_end, "avg_us", &avg) == false) {
+                    fprintf(out, " - |");
+                } else if(first_avg) {
+                    uint32_t ratio = (uint32_t)((uint64_t)avg * 100 / first_avg);
+                    fprintf(out, " %u us (%u.%02ux) |", (unsigned int)avg, (unsigned int)(ratio / 100), (unsigned int)(ratio % 100));
+                } else {
+                    fprintf(out, " %u us |", (unsigned int)avg);
+                }
+            }
+            fprintf(out, "\n");
+            row_cnt++;
+        }
+
+        obj = strchr(obj_end, '{');
+    }
+
+    for(f = 0; f < cnt; f++) free(txts[f]);
+    free(txts);
+
+    return row_cnt;
+}
+
+/**
+ * Start storing the timeline of the benchmark (see `benchmark_set_trace_cb()`) in memory.
+ * The events are only copied during the tests so the tracing hardly changes the measured times.
+ * @return true: started; false: not enough memory for `BENCHMARK_HEADLESS_TRACE_MAX` events
+ */
+bool benchmark_headless_trace_start(void)
+{
+    free(trace_buf);
+    trace_buf = malloc(BENCHMARK_HEADLESS_TRACE_MAX * sizeof(benchmark_trace_event_t));
+    if(trace_buf == NULL) return false;
+
+    trace_cnt = 0;
+    trace_lost = 0;
+    trace_begin = benchmark_headless_clock_ns();
+    benchmark_set_trace_cb(trace_store);
+
+    return true;
+}
+
+/**
+ * Stop the tracing and write the stored events in the Trace Event Format
+ * which can be opened by `chrome://tracing` or https://ui.perfetto.dev.
+ * The refreshes are slices with their rendering, flushing and waiting nested in them,
+ * `px_num` and `heap` are counters, the style and scene changes are instant events.
+ * @param f the output stream
+ * @return number of written events
+ */
+uint32_t benchmark_headless_trace_write(FILE * f)
+{
+    benchmark_set_trace_cb(NULL);
+
+    fprintf(f, "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [\n");
+    fprintf(f, "  {\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": 1, \"args\": {\"name\": \"lv_task_handler\"}}");
+
+    uint32_t i;
+    for(i = 0; i < trace_cnt; i++) {
+        const benchmark_trace_event_t * e = &trace_buf[i];
+        const char * slice = NULL;
+        switch(e->type) {
+            case BENCHMARK_TRACE_REFR:
+                slice = "refresh";
+                break;
+            case BENCHMARK_TRACE_RENDER:
+                slice = "render";
+                break;
+            case BENCHMARK_TRACE_FLUSH:
+                slice = "flush";
+                break;
+            case BENCHMARK_TRACE_WAIT:
+                slice = "wait";
+                break;
+            case BENCHMARK_TRACE_UPDATE:
+                slice = "update";
+                break;
+            default:
+                break;
+        }
+
+        fprintf(f, ",\n  {");
+        if(slice) {
+            fprintf(f, "\"name\": \"%s\", \"cat\": \"lvgl\", \"ph\": \"X\", \"pid\": 1, \"tid\": 1, \"ts\": ", slice);
+            trace_ts(f, e->start);
+            fprintf(f, ", \"dur\": %u.%03u", (unsigned int)(e->dur / 1000), (unsigned int)(e->dur % 1000));
+            if(e->type == BENCHMARK_TRACE_REFR || e->type == BENCHMARK_TRACE_FLUSH) {
+                fprintf(f, ", \"args\": {\"px_num\": %u}", (unsigned int)e->value);
+            }
+            fprintf(f, "}");
+
+            /*Show the refreshed pixels as a counter too*/
+            if(e->type == BENCHMARK_TRACE_REFR) {
+                fprintf(f, ",\n  {\"name\": \"px_num\", \"ph\": \"C\", \"pid\": 1, \"ts\": ");
+                trace_ts(f, e->start);
+                fprintf(f, ", \"args\": {\"px_num\": %u}}", (unsigned int)e->value);
+            }
+        } else if(e->type == BENCHMARK_TRACE_MEM) {
+            fprintf(f, "\"name\": \"heap\", \"ph\": \"C\", \"pid\": 1, \"ts\": ");
+            trace_ts(f, e->start);
+            fprintf(f, ", \"args\": {\"used\": %u}}", (unsigned int)e->value);
+        } else if(e->type == BENCHMARK_TRACE_STYLE) {
+            fprintf(f, "\"name\": \"%s\", \"cat\": \"style\", \"ph\": \"i\", \"s\": \"g\", \"pid\": 1, \"tid\": 1, \"ts\": ",
+                    e->name ? e->name : "style");
+            trace_ts(f, e->start);
+            fprintf(f, ", \"args\": {\"style\": \"%s\"}}", benchmark_get_style_name((uint8_t)e->value));
+        } else {
+            fprintf(f, "\"name\": \"%s\", \"cat\": \"scene\", \"ph\": \"i\", \"s\": \"g\", \"pid\": 1, \"tid\": 1, \"ts\": ",
+                    e->name ? e->name : "scene");
+            trace_ts(f, e->start);
+            fprintf(f, "}");
+        }
+    }
+
+    fprintf(f, "\n], \"otherData\": {\"lvgl\": \"%d.%d.%d\", \"dropped_events\": %u}}\n",
+            LVGL_VERSION_MAJOR, LVGL_VERSION_MINOR, LVGL_VERSION_PATCH, (unsigned int)trace_lost);
+
+    uint32_t cnt = trace_cnt;
+    free(trace_buf);
+    trace_buf = NULL;
+    trace_cnt = 0;
+
+    return cnt;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Copy the rendered area into the in-memory frame buffer
+ * @param drv pointer to the display driver
+ * @param area the area to flush
+ * @param color_p the rendered pixels of `area`
+ */
+static void mem_flush(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    fb_copy(drv->hor_res, area, color_p);
+
+    lv_disp_flush_ready(drv);
+}
+
+/**
+ * Start sending the pixels to the emulated panel in the background
+ * @param drv pointer to the display driver
+ * @param area the area to flush
+ * @param color_p the rendered pixels of `area`
+ */
+static void dma_flush(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    (void) drv; /*Unused*/
+
+    pthread_mutex_lock(&dma_mutex);
+    dma_area = *area;
+    dma_color_p = color_p;
+    dma_pending = true;
+    pthread_cond_signal(&dma_cond);
+    pthread_mutex_unlock(&dma_mutex);
+}
+
+/**
+ * Let the emulated DMA finish the last flush and stop its thread if it runs
+ */
+static void dma_stop(void)
+{
+    if(dma_run == false) return;
+
+    pthread_mutex_lock(&dma_mutex);
+    dma_run = false;
+    pthread_cond_signal(&dma_cond);
+    pthread_mutex_unlock(&dma_mutex);
+    pthread_join(dma_tid, NULL);
+}
+
+/**
+ * Free the draw buffers and the frame buffer of the headless display
+ */
+static void buf_free(void)
+{
+    free(draw_buf);
+    free(draw_buf2);
+    free(fb);
+    draw_buf = NULL;
+    draw_buf2 = NULL;
+    fb = NULL;
+}
+
+/**
+ * The emulated DMA. Copies a flushed area to `fb`, waits for the transfer time and tells the flush is ready.
+ * @param param unused
+ * @return NULL
+ */
+static void * dma_thread(void * param)
+{
+    (void) param; /*Unused*/
+
+    while(1) {
+        pthread_mutex_lock(&dma_mutex);
+        while(dma_pending == false && dma_run) pthread_cond_wait(&dma_cond, &dma_mutex);
+        if(dma_pending == false) {
+            pthread_mutex_unlock(&dma_mutex);
+            break;
+        }
+        lv_area_t area = dma_area;
+        const lv_color_t * color_p = dma_color_p;
+        dma_pending = false;
+        pthread_mutex_unlock(&dma_mutex);
+
+        uint64_t end = benchmark_headless_clock_ns() + (uint64_t)lv_area_get_size(&area) * flush_ns_per_px;
+        fb_copy(disp_drv.hor_res, &area, color_p);
+
+        struct timespec ts;
+        ts.tv_sec = end / 1000000000;
+        ts.tv_nsec = end % 1000000000;
+        while(clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) != 0);
+
+        lv_disp_flush_ready(&disp_drv);
+    }
+
+    return NULL;
+}
+
+/**
+ * Copy an area into the emulated panel's memory
+ * @param hres horizontal resolution
+ * @param area the area to copy
+ * @param color_p the pixels of `area`
+ */
+static void fb_copy(lv_coord_t hres, const lv_area_t * area, const lv_color_t * color_p)
+{
+    lv_coord_t w = area->x2 - area->x1 + 1;
+    lv_coord_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        memcpy(&fb[(uint32_t)y * hres + area->x1], color_p, w * sizeof(lv_color_t));
+        color_p += w;
+    }
+}
+
+/**
+ * Collect the tests measured in the last run
+ * @return number of entries in `res_entries`
+ */
+static uint16_t res_collect(void)
+{
+    res_entry_cnt = 0;
+
+    /*The benchmark keeps the results of the last buffer configuration only*/
+    if(buf_cnt) {
+        uint16_t b;
+        for(b = 0; b < buf_cnt; b++) {
+            uint16_t i;
+            for(i = 0; i < buf_entries[b].scene_cnt; i++) {
+                res_add(buf_entries[b].names[i], buf_entries[b].config, &buf_entries[b].res[i]);
+            }
+        }
+
+        return res_entry_cnt;
+    }
+
+    /*The benchmark keeps the matrix of the last resolution only*/
+    if(sweep_cnt) {
+        uint16_t r;
+        for(r = 0; r < sweep_cnt; r++) {
+            uint8_t s;
+            for(s = 0; s < BENCHMARK_STYLE_NUM; s++) {
+                res_add(sweep_entries[r].scene, benchmark_get_style_name(s), &sweep_entries[r].res[s]);
+            }
+        }
+
+        return res_entry_cnt;
+    }
+
+    if(benchmark_matrix_is_valid()) {
+        uint8_t s;
+        for(s = 0; s < BENCHMARK_STYLE_NUM; s++) {
+            res_add("holder_page", benchmark_get_style_name(s), benchmark_get_matrix_result(s));
+        }
+    }
+
+    uint16_t i;
+    for(i = 0; i < benchmark_get_scene_cnt(); i++) {
+        res_add(benchmark_get_scene_name(i), benchmark_get_style_name(0), benchmark_get_scene_result(i));
+        res_entries[res_entry_cnt - 1].dirty = benchmark_get_dirty_result(i);
+        res_entries[res_entry_cnt - 1].text = benchmark_get_text_result(i);
+        res_entries[res_entry_cnt - 1].img = benchmark_get_img_result(benchmark_get_scene_name(i));
+        if(res_entries[res_entry_cnt - 1].dirty == NULL && res_entries[res_entry_cnt - 1].text == NULL &&
+           res_entries[res_entry_cnt - 1].img == NULL) {
+            res_entries[res_entry_cnt - 1].has_cost = true;
+            res_entries[res_entry_cnt - 1].ns_per_kpx = benchmark_get_scene_cost(i);
+        }
+    }
+
+    if(res_entry_cnt == 0 && benchmark_get_anim_cnt() == 0 && benchmark_get_result()) {
+        res_add("holder_page", benchmark_get_style_name(benchmark_get_style()), benchmark_get_result());
+    }
+
+    return res_entry_cnt;
+}
+
+/**
+ * Add a test to `res_entries`
+ * @param scene name of the measured scene
+ * @param config name of the style combination
+ * @param res the statistics
+ */
+static void res_add(const char * scene, const char * config, const benchmark_result_t * res)
+{
+    if(res_entry_cnt >= RES_ENTRY_MAX) return;
+
+    res_entry_t * e = &res_entries[res_entry_cnt];
+    strncpy(e->scene, scene, sizeof(e->scene) - 1);
+    e->scene[sizeof(e->scene) - 1] = '\0';
+    strncpy(e->config, config, sizeof(e->config) - 1);
+    e->config[sizeof(e->config) - 1] = '\0';
+    e->res = res;
+    e->has_cost = false;
+    e->ns_per_kpx = 0;
+    e->dirty = NULL;
+    e->text = NULL;
+    e->img = NULL;
+
+    res_entry_cnt++;
+}
+
+/**
+ * Write a test as a JSON object of the result list
+ * @param f the output stream
+ * @param e the test to write
+ * @param last true: it's the last item of the list (no comma after it)
+ */
+static void write_result(FILE * f, const res_entry_t * e, bool last)
+{
+    const benchmark_result_t * res = e->res;
+
+    fprintf(f, "    {\"scene\": \"%s\", \"config\": \"%s\", \"samples\": %u, \"first_us\": %u, "
+            "\"avg_us\": %u, \"min_us\": %u, \"max_us\": %u, "
+            "\"p50_us\": %u, \"p95_us\": %u, \"p99_us\": %u, \"std_dev_us\": %u, "
+            "\"px_per_refr\": %u, \"mpx_per_s\": %u.%03u, "
+            "\"render_us\": %u, \"flush_us\": %u, \"wait_us\": %u",
+            e->scene, e->config, (unsigned int)res->sample_cnt, (unsigned int)res->first,
+            (unsigned int)res->avg, (unsigned int)res->min, (unsigned int)res->max,
+            (unsigned int)res->p50, (unsigned int)res->p95, (unsigned int)res->p99, (unsigned int)res->std_dev,
+            (unsigned int)res->px_per_refr, (unsigned int)(res->kpx_per_sec / 1000), (unsigned int)(res->kpx_per_sec % 1000),
+            (unsigned int)res->render_avg, (unsigned int)res->flush_avg, (unsigned int)res->wait_avg);
+
+    fprintf(f, ", \"mem_peak\": %u, \"frag_pct\": %u", (unsigned int)res->mem_peak, (unsigned int)res->frag_pct);
+#if BENCHMARK_HEADLESS_MEM_WRAP
+    fprintf(f, ", \"allocs\": %u, \"frees\": %u", (unsigned int)res->alloc_cnt, (unsigned int)res->free_cnt);
+#endif
+
+    if(e->has_cost) fprintf(f, ", \"ns_per_kpx\": %u", (unsigned int)e->ns_per_kpx);
+
+    if(e->dirty) {
+        fprintf(f, ", \"areas\": %u, \"joined_areas\": %u, \"join_ns\": %u, \"update_us\": %u, \"full_avg_us\": %u, \"ns_per_area\": %u",
+                (unsigned int)e->dirty->area_avg, (unsigned int)e->dirty->joined_avg, (unsigned int)e->dirty->join_ns,
+                (unsigned int)e->dirty->update_avg, (unsigned int)e->dirty->full_avg, (unsigned int)e->dirty->ns_per_area);
+    }
+
+    if(e->text) {
+        fprintf(f, ", \"chars\": %u, \"update_us\": %u, \"kchar_per_s\": %u, \"ns_per_char\": %u",
+                (unsigned int)e->text->char_cnt, (unsigned int)res->update_avg,
+                (unsigned int)e->text->kchar_per_sec, (unsigned int)e->text->ns_per_char);
+    }
+
+    if(e->img) {
+        fprintf(f, ", \"decode_us\": %u, \"cache_mem\": %u",
+                (unsigned int)e->img->decode_time, (unsigned int)e->img->cache_mem);
+    }
+
+    /*Counters per refresh. Few instructions per cycle means the CPU waits for memory.*/
+    uint8_t c;
+    for(c = 0; c < BENCHMARK_CNT_NUM; c++) {
+        if(benchmark_headless_cnt_is_avail(c)) {
+            fprintf(f, ", \"%s\": %llu", cnt_names[c], (unsigned long long)res->cnt_avg[c]);
+        }
+    }
+
+    if(benchmark_headless_cnt_is_avail(BENCHMARK_CNT_INSTR) && benchmark_headless_cnt_is_avail(BENCHMARK_CNT_CYCLE) &&
+       res->cnt_avg[BENCHMARK_CNT_CYCLE] != 0) {
+        uint32_t ipc = (uint32_t)(res->cnt_avg[BENCHMARK_CNT_INSTR] * 100 / res->cnt_avg[BENCHMARK_CNT_CYCLE]);
+        fprintf(f, ", \"ipc\": %u.%02u", (unsigned int)(ipc / 100), (unsigned int)(ipc % 100));
+    }
+
+    fprintf(f, "}%s\n", last ? "" : ",");
+}
+
+/**
+ * Write the scaling curve of the resolution sweep as a JSON list.
+ * `linearity` is the growth of the time divided by the growth of the pixels compared to the first resolution:
+ * 1.00 means the time grows linearly with the pixels, above it the larger screen is more expensive per pixel.
+ * @param f the output stream
+ */
+static void write_sweep(FILE * f)
+{
+    const sweep_entry_t * first = &sweep_entries[0];
+    uint64_t px_first = (uint64_t)first->hres * first->vres;
+
+    fprintf(f, ",\n  \"sweep\": [\n");
+
+    uint16_t r;
+    for(r = 0; r < sweep_cnt; r++) {
+        const sweep_entry_t * e = &sweep_entries[r];
+        uint64_t px = (uint64_t)e->hres * e->vres;
+        fprintf(f, "    {\"hor_res\": %d, \"ver_res\": %d, \"px\": %u, \"curve\": [\n",
+                e->hres, e->vres, (unsigned int)px);
+
+        uint8_t s;
+        for(s = 0; s < BENCHMARK_STYLE_NUM; s++) {
+            const benchmark_result_t * res = &e->res[s];
+            uint32_t ns_per_px = (uint32_t)((uint64_t)res->avg * 1000 / px);
+            uint32_t lin = 0;
+            if(first->res[s].avg) lin = (uint32_t)((uint64_t)res->avg * px_first * 100 / ((uint64_t)first->res[s].avg * px));
+
+            fprintf(f, "      {\"config\": \"%s\", \"avg_us\": %u, \"p95_us\": %u, \"ns_per_px\": %u, \"linearity\": %u.%02u}%s\n",
+                    benchmark_get_style_name(s), (unsigned int)res->avg, (unsigned int)res->p95, (unsigned int)ns_per_px,
+                    (unsigned int)(lin / 100), (unsigned int)(lin % 100), s == BENCHMARK_STYLE_NUM - 1 ? "" : ",");
+        }
+
+        fprintf(f, "    ]}%s\n", r == sweep_cnt - 1 ? "" : ",");
+    }
+
+    fprintf(f, "  ]");
+}
+
+/**
+ * Write the RAM and the average frame time of each draw buffer configuration as a JSON list
+ * @param f the output stream
+ */
+static void write_buf_sweep(FILE * f)
+{
+    fprintf(f, ",\n  \"buffers\": [\n");
+
+    uint16_t b;
+    for(b = 0; b < buf_cnt; b++) {
+        const buf_entry_t * e = &buf_entries[b];
+        uint64_t avg_sum = 0;
+        uint64_t wait_sum = 0;
+        uint16_t i;
+        for(i = 0; i < e->scene_cnt; i++) {
+            avg_sum += e->res[i].avg;
+            wait_sum += e->res[i].wait_avg;
+        }
+
+        fprintf(f, "    {\"config\": \"%s\", \"div\": %d, \"double\": %s, \"ram\": %u, \"frame_us\": %u, \"wait_us\": %u}%s\n",
+                e->config, e->div, e->dbl ? "true" : "false", (unsigned int)e->ram,
+                (unsigned int)(e->scene_cnt ? avg_sum / e->scene_cnt : 0),
+                (unsigned int)(e->scene_cnt ? wait_sum / e->scene_cnt : 0),
+                b == buf_cnt - 1 ? "" : ",");
+    }
+
+    fprintf(f, "  ]");
+}
+
+/**
+ * Read a whole file into a '\0' terminated buffer
+ * @param path path to the file
+ * @return the content of the file (free it with `free()`) or NULL on error
+ */
+static char * file_read(const char * path)
+{
+    FILE * f = fopen(path, "rb");
+    if(f == NULL) return NULL;
+
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    if(size < 0) {
+        fclose(f);
+        return NULL;
+    }
+
+    char * buf = malloc(size + 1);
+    if(buf == NULL) {
+        fclose(f);
+        return NULL;
+    }
+
+    size_t rn = fread(buf, 1, size, f);
+    buf[rn] = '\0';
+    fclose(f);
+
+    return buf;
+}
+
+/**
+ * Find a key in a flat JSON object
+ * @param obj start of the object
+ * @param obj_end end of the object
+ * @param key the key to find (without quotes)
+ * @return pointer to the value or NULL if not found
+ */
+static const char * json_find(const char * obj, const char * obj_end, const char * key)
+{
+    size_t key_len = strlen(key);
+    const char * p = obj;
+    while((p = strchr(p, '"')) != NULL && p < obj_end) {
+        if(strncmp(p + 1, key, key_len) == 0 && p[key_len + 1] == '"') {
+            p += key_len + 2;
+            while(*p == ' ' || *p == ':') p++;
+            return p < obj_end ? p : NULL;
+        }
+        p++;
+    }
+
+    return NULL;
+}
+
+/**
+ * Find a test in the `results` list of a JSON written by `benchmark_headless_write_json()`.
+ * The result objects have no nested objects or lists.
+ * @param txt the whole JSON
+ * @param scene name of the scene
+ * @param config name of the configuration
+ * @param obj_end store the end of the found object here
+ * @return start of the found object or NULL if not found
+ */
+static const char * json_find_result(const char * txt, const char * scene, const char * config, const char ** obj_end)
+{
+    const char * res = strstr(txt, "\"results\"");
+    if(res == NULL) return NULL;
+
+    const char * res_end = strchr(res, ']');
+    if(res_end == NULL) return NULL;
+
+    const char * obj = strchr(res, '{');
+    while(obj && obj < res_end) {
+        const char * end = strchr(obj, '}');
+        if(end == NULL) break;
+
+        char obj_scene[32];
+        char obj_config[32];
+        if(json_get_str(obj, end, "scene", obj_scene, sizeof(obj_scene)) &&
+           json_get_str(obj, end, "config", obj_config, sizeof(obj_config)) &&
+           strcmp(obj_scene, scene) == 0 && strcmp(obj_config, config) == 0) {
+            *obj_end = end;
+            return obj;
+        }
+
+        obj = strchr(end, '{');
+    }
+
+    return NULL;
+}
+
+/**
+ * Get a string value from a flat JSON object
+ * @param obj start of the object
+ * @param obj_end end of the object
+ * @param key the key to find (without quotes)
+ * @param buf copy the value here
+ * @param buf_size size of `buf`
+ * @return true: found
+ */
+static bool json_get_str(const char * obj, const char * obj_end, const char * key, char * buf, size_t buf_size)
+{
+    const char * v = json_find(obj, obj_end, key);
+    if(v == NULL || *v != '"') return false;
+
+    v++;
+    size_t i = 0;
+    while(v[i] != '"' && v[i] != '\0' && i < buf_size - 1) {
+        buf[i] = v[i];
+        i++;
+    }
+    buf[i] = '\0';
+
+    return true;
+}
+
+/**
+ * Get an unsigned integer value from a flat JSON object
+ * @param obj start of the object
+ * @param obj_end end of the object
+ * @param key the key to find (without quotes)
+ * @param v store the value here
+ * @return true: found
+ */
+static bool json_get_uint(const char * obj, const char * obj_end, const char * key, uint32_t * v)
+{
+    const char * p = json_find(obj, obj_end, key);
+    if(p == NULL || *p < '0' || *p > '9') return false;
+
+    *v = strtoul(p, NULL, 10);
+
+    return true;
+}
+
+#ifdef __linux__
+/**
+ * Open a counter of the calling thread with `perf_event_open`
+ * @param type `PERF_TYPE_...`
+ * @param config the event of `type` to count
+ * @return file descriptor of the counter or -1 on error
+ */
+static int perf_open(uint32_t type, uint64_t config)
+{
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    attr.exclude_kernel = 1;        /*Allowed with `perf_event_paranoid` <= 2*/
+    attr.exclude_hv = 1;
+
+    int fd = (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+    if(fd < 0) return -1;
+
+    return fd;
+}
+#endif
+
+/**
+ * Store an event of the benchmark. Set by `benchmark_headless_trace_start()`.
+ * @param e pointer to the event
+ */
+static void trace_store(const benchmark_trace_event_t * e)
+{
+    if(trace_cnt >= BENCHMARK_HEADLESS_TRACE_MAX) {
+        trace_lost++;
+        return;
+    }
+
+    trace_buf[trace_cnt] = *e;
+    trace_cnt++;
+}
+
+/**
+ * Write a timestamp of the trace in microseconds with nanosecond decimals
+ * @param f the output stream
+ * @param t clock value in nanoseconds
+ */
+static void trace_ts(FILE * f, uint64_t t)
+{
+    uint64_t rel = t > trace_begin ? t - trace_begin : 0;
+    fprintf(f, "%llu.%03u", (unsigned long long)(rel / 1000), (unsigned int)(rel % 1000));
+}
+
+#if BENCHMARK_HEADLESS_MEM_WRAP
+/**
+ * Add a new block to the allocated bytes and update their peak
+ * @param size size of the block in bytes
+ */
+static void mem_alloc_add(uint32_t size)
+{
+    mem_alloc_size += size;
+    if(mem_alloc_size > mem_alloc_max) mem_alloc_max = mem_alloc_size;
+}
+#endif
+
+#endif /*LV_USE_BENCHMARK && LV_USE_BENCHMARK_HEADLESS*/
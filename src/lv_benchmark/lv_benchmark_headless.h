@@ -0,0 +1,226 @@
+/**
+ * @file lv_benchmark_headless.h
+ *
+ */
+
+#ifndef BENCHMARK_HEADLESS_H
+#define BENCHMARK_HEADLESS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_benchmark.h"
+
+#ifndef LV_USE_BENCHMARK_HEADLESS
+#define LV_USE_BENCHMARK_HEADLESS   0
+#endif
+
+#if LV_USE_BENCHMARK && LV_USE_BENCHMARK_HEADLESS
+
+#include <stdio.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define BENCHMARK_HEADLESS_BUF_DIV      10      /*Default draw buffer size: 1/10 of the screen*/
+#define BENCHMARK_HEADLESS_DEF_THRESHOLD 10     /*Default slow down in percent to fail the comparison*/
+#define BENCHMARK_HEADLESS_SWEEP_MAX    8       /*Max. number of resolutions in a sweep*/
+#define BENCHMARK_HEADLESS_BUF_SWEEP_NUM 8      /*Draw buffer configurations in a buffer sweep*/
+
+#ifndef BENCHMARK_HEADLESS_TRACE_MAX
+#define BENCHMARK_HEADLESS_TRACE_MAX    65536   /*Max. number of stored trace events. The later ones are dropped.*/
+#endif
+
+/*1: count the allocations by linking with `-Wl,--wrap=lv_mem_alloc,--wrap=lv_mem_free,--wrap=lv_mem_realloc`*/
+#ifndef BENCHMARK_HEADLESS_MEM_WRAP
+#define BENCHMARK_HEADLESS_MEM_WRAP     0
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Create a display which renders into RAM only and make it the default display.
+ * Only one headless display can exist at a time.
+ * @param hres horizontal resolution
+ * @param vres vertical resolution
+ * @return pointer to the created display or NULL if there was not enough memory
+ */
+lv_disp_t * benchmark_headless_disp_create(lv_coord_t hres, lv_coord_t vres);
+
+/**
+ * Set the draw buffers of the next `benchmark_headless_disp_create()`
+ * @param div the size of a buffer is 1/`div` of the screen (e.g. 10, 4, 2, 1)
+ * @param dbl true: use two buffers so rendering continues while the other buffer is flushed
+ */
+void benchmark_headless_set_buf(uint8_t div, bool dbl);
+
+/**
+ * Emulate a panel which receives the pixels in the background (e.g. SPI with DMA)
+ * so the flush takes time but doesn't block the CPU. Applies from the next `benchmark_headless_disp_create()`.
+ * Without it the flush is a `memcpy` which is ready immediately so double buffering doesn't matter.
+ * @param ns_per_px transfer time of a pixel in nanoseconds (e.g. 400 for 16 bit pixels on a 40 MHz SPI) or 0 to not emulate
+ */
+void benchmark_headless_set_flush_time(uint32_t ns_per_px);
+
+/**
+ * Delete the headless display with its screens and free its buffers.
+ * A new display can be created after it.
+ * @param disp pointer to a display created by `benchmark_headless_disp_create`
+ */
+void benchmark_headless_disp_del(lv_disp_t * disp);
+
+/**
+ * Get the elapsed milliseconds from the host's monotonic clock.
+ * Use it as `LV_TICK_CUSTOM_SYS_TIME_EXPR` so no tick interrupt is required.
+ * @return milliseconds since the first call
+ */
+uint32_t benchmark_headless_tick_get(void);
+
+/**
+ * Get the time from the host's monotonic clock in nanoseconds.
+ * Pass it to `benchmark_set_clock_cb()` to measure the refreshes with sub-millisecond resolution.
+ * @return nanoseconds since an arbitrary point
+ */
+uint64_t benchmark_headless_clock_ns(void);
+
+/**
+ * Open the hardware performance counters of this thread with `perf_event_open`.
+ * Pass `benchmark_headless_cnt_read` to `benchmark_set_cnt_cb()` to use them.
+ * The counters which are not supported (not Linux, no permission, virtual machine etc.) are skipped.
+ * @return number of opened counters
+ */
+uint8_t benchmark_headless_cnt_open(void);
+
+/**
+ * Close the counters opened by `benchmark_headless_cnt_open()`
+ */
+void benchmark_headless_cnt_close(void);
+
+/**
+ * Tell whether a hardware counter could be opened
+ * @param id a `BENCHMARK_CNT_...` value
+ * @return true: the counter is available
+ */
+bool benchmark_headless_cnt_is_avail(uint8_t id);
+
+/**
+ * Read the current value of the hardware counters. The not available ones are 0.
+ * @param values store the `BENCHMARK_CNT_NUM` values here
+ */
+void benchmark_headless_cnt_read(uint64_t * values);
+
+/**
+ * Read the number of `lv_mem` allocations and frees since the start.
+ * Pass it to `benchmark_set_mem_cnt_cb()`. Counts only with `BENCHMARK_HEADLESS_MEM_WRAP`, else both are 0.
+ * @param alloc_cnt store the number of allocations here (a reallocation which moves the data counts as an allocation and a free)
+ * @param free_cnt store the number of frees here
+ */
+void benchmark_headless_mem_cnt_read(uint32_t * alloc_cnt, uint32_t * free_cnt);
+
+/**
+ * Read the most bytes allocated with `lv_mem` at once.
+ * Pass it to `benchmark_set_mem_peak_cb()`. Follows the allocations only with `BENCHMARK_HEADLESS_MEM_WRAP`, else returns 0.
+ * @param reset true: restart from the currently allocated bytes
+ * @return the peak of the allocated bytes since the last reset
+ */
+uint32_t benchmark_headless_mem_peak_read(bool reset);
+
+/**
+ * Call `lv_task_handler()` in a loop until the started benchmark is ready
+ * @param timeout_ms give up after this many milliseconds
+ * @return true: the benchmark finished; false: timeout
+ */
+bool benchmark_headless_run(uint32_t timeout_ms);
+
+/**
+ * Run the style matrix on displays with different resolutions one after the other.
+ * For each resolution a new headless display and benchmark is created and deleted when the matrix is finished.
+ * The results are written by `benchmark_headless_write_json()` with the resolution in the scene's name
+ * and a `sweep` list which compares the time per pixel of the resolutions.
+ * @param res_list pairs of horizontal and vertical resolutions (e.g. `{320, 240, 480, 272}`)
+ *                 or NULL to use 320x240, 480x272, 800x480, 1024x600 and 1280x720
+ * @param cnt number of resolutions in `res_list`. Limited to `BENCHMARK_HEADLESS_SWEEP_MAX`.
+ * @param timeout_ms give up a resolution after this many milliseconds
+ * @return number of measured resolutions. Stops at the first one which couldn't be created or timed out.
+ */
+uint16_t benchmark_headless_sweep(const lv_coord_t * res_list, uint16_t cnt, uint32_t timeout_ms);
+
+/**
+ * Measure the drawing primitive scenes with 1/10, 1/4, 1/2 and full screen sized draw buffers,
+ * with one and two buffers each. For each configuration a new headless display and benchmark is created.
+ * The results are written by `benchmark_headless_write_json()` with the buffer configuration as `config`
+ * and a `buffers` list with the RAM of the buffers and the average frame time of the scenes.
+ * A configuration is skipped if its buffers can't be allocated.
+ * @param hres horizontal resolution
+ * @param vres vertical resolution
+ * @param timeout_ms give up a configuration after this many milliseconds
+ * @return number of measured configurations. Stops at the first one which timed out.
+ */
+uint16_t benchmark_headless_buf_sweep(lv_coord_t hres, lv_coord_t vres, uint32_t timeout_ms);
+
+/**
+ * Write the result of the last benchmark run as JSON
+ * @param f the output stream
+ */
+void benchmark_headless_write_json(FILE * f);
+
+/**
+ * Compare the results of the last run with a baseline written earlier by `benchmark_headless_write_json()`.
+ * A test is slower if its average time grew by more than `threshold_pct` percent
+ * and by more than the measurement noise.
+ * @param baseline_path path to the baseline JSON file
+ * @param threshold_pct the smallest slow down in percent to report
+ * @param report the difference of each test is written here
+ * @return number of slower tests or -1 if the baseline couldn't be read
+ */
+int32_t benchmark_headless_compare(const char * baseline_path, uint32_t threshold_pct, FILE * report);
+
+/**
+ * Print the average times of result files side by side as a Markdown table, e.g. to compare builds
+ * with different `LV_COLOR_DEPTH` and `LV_ANTIALIAS`. The tests of the first file are the rows,
+ * the other files are compared to it.
+ * @param paths paths to JSON files written by `benchmark_headless_write_json()`
+ * @param cnt number of files
+ * @param out the table is written here
+ * @return number of rows or -1 if a file couldn't be read
+ */
+int32_t benchmark_headless_table(const char * const * paths, uint16_t cnt, FILE * out);
+
+/**
+ * Start storing the timeline of the benchmark (see `benchmark_set_trace_cb()`) in memory.
+ * The events are only copied during the tests so the tracing hardly changes the measured times.
+ * @return true: started; false: not enough memory for `BENCHMARK_HEADLESS_TRACE_MAX` events
+ */
+bool benchmark_headless_trace_start(void);
+
+/**
+ * Stop the tracing and write the stored events in the Trace Event Format
+ * which can be opened by `chrome://tracing` or https://ui.perfetto.dev.
+ * The refreshes are slices with their rendering, flushing and waiting nested in them,
+ * `px_num` and `heap` are counters, the style and scene changes are instant events.
+ * @param f the output stream
+ * @return number of written events
+ */
+uint32_t benchmark_headless_trace_write(FILE * f);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_BENCHMARK && LV_USE_BENCHMARK_HEADLESS*/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* BENCHMARK_HEADLESS_H */
@@ -0,0 +1,458 @@
+/**
+ * @file lv_benchmark_img.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_benchmark.h"
+#if LV_USE_BENCHMARK
+
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define RAM_DRIVE_LETTER    'B'
+#define RAM_FILE_NAME       "benchmark_bg.bin"
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*An opened file of the RAM drive*/
+typedef struct {
+    uint32_t pos;
+} ram_file_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static uint32_t array_create(lv_obj_t * scr);
+static uint32_t img_scene_create(lv_obj_t * scr, const char * name, const void * src, bool to_ram);
+#if LV_USE_FILESYSTEM
+static uint32_t file_create(lv_obj_t * scr);
+static uint32_t cached_create(lv_obj_t * scr);
+static void file_update(uint32_t frame);
+static void cached_img_event_cb(lv_obj_t * img, lv_event_t event);
+static void ram_drive_init(void);
+static lv_fs_res_t ram_open(lv_fs_drv_t * drv, void * file_p, const char * path, lv_fs_mode_t mode);
+static lv_fs_res_t ram_close(lv_fs_drv_t * drv, void * file_p);
+static lv_fs_res_t ram_read(lv_fs_drv_t * drv, void * file_p, void * buf, uint32_t btr, uint32_t * br);
+static lv_fs_res_t ram_seek(lv_fs_drv_t * drv, void * file_p, uint32_t pos);
+static lv_fs_res_t ram_tell(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p);
+static lv_fs_res_t ram_size(lv_fs_drv_t * drv, void * file_p, uint32_t * size_p);
+static lv_res_t ram_decoder_info(lv_img_decoder_t * decoder, const void * src, lv_img_header_t * header);
+static lv_res_t ram_decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc);
+static void ram_decoder_close(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static const benchmark_scene_t img_scenes[] = {
+    {"img_array", array_create, NULL},
+#if LV_USE_FILESYSTEM
+    {"img_file", file_create, file_update},
+    {"img_cached", cached_create, NULL},
+#endif
+};
+
+static benchmark_img_result_t img_res[sizeof(img_scenes) / sizeof(img_scenes[0])];
+static bool img_res_valid[sizeof(img_scenes) / sizeof(img_scenes[0])];
+
+#if LV_USE_FILESYSTEM
+static const char * file_path = "B:"RAM_FILE_NAME;
+static bool decode_to_ram;      /*The RAM decoder takes `file_path` instead of the built-in decoder while the cached scene exists*/
+static lv_fs_drv_t ram_drv;
+static lv_img_decoder_t * ram_decoder;
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+LV_IMG_DECLARE(benchmark_bg)
+
+/**
+ * Get the scenes which draw the same image from different sources: the C array (`img_array`),
+ * a file read through the built-in decoder on every draw (`img_file`)
+ * and the file decoded into RAM once and kept in the image cache (`img_cached`).
+ * Use them with `benchmark_start_scenes()` and get the decoding cost with `benchmark_get_img_result()`.
+ * The file scenes need `LV_USE_FILESYSTEM`.
+ * @param cnt store the number of scenes here
+ * @return the array of scenes
+ */
+const benchmark_scene_t * benchmark_get_img_scenes(uint16_t * cnt)
+{
+    *cnt = sizeof(img_scenes) / sizeof(img_scenes[0]);
+    return img_scenes;
+}
+
+/**
+ * Get the decoding cost of an image scene measured by `benchmark_start_scenes()`
+ * @param name name of the scene
+ * @return pointer to the result or NULL if `name` is not a measured image scene
+ */
+const benchmark_img_result_t * benchmark_get_img_result(const char * name)
+{
+    uint16_t i;
+    for(i = 0; i < sizeof(img_scenes) / sizeof(img_scenes[0]); i++) {
+        if(strcmp(img_scenes[i].name, name) == 0) return img_res_valid[i] ? &img_res[i] : NULL;
+    }
+
+    return NULL;
+}
+
+#if LV_USE_FILESYSTEM
+/**
+ * Set the image file of the file scenes. By default a RAM drive serves `benchmark_bg` as a file
+ * so only the cost of the decoder is measured. Set a file on the real storage to measure the reading too.
+ * @param path path of an image converted to LittlevGL's binary format (`.bin`) with true color format.
+ *             Only the pointer is saved so it should be static.
+ */
+void benchmark_set_img_file(const char * path)
+{
+    file_path = path;
+}
+#endif
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * The image from the compiled-in C array
+ * @param scr pointer to the scene's screen
+ * @return 0: the images are compared by their times
+ */
+static uint32_t array_create(lv_obj_t * scr)
+{
+    return img_scene_create(scr, "img_array", &benchmark_bg, false);
+}
+
+#if LV_USE_FILESYSTEM
+/**
+ * The image from a file read line by line by the built-in decoder on every draw
+ * @param scr pointer to the scene's screen
+ * @return 0: the images are compared by their times
+ */
+static uint32_t file_create(lv_obj_t * scr)
+{
+    return img_scene_create(scr, "img_file", file_path, false);
+}
+
+/**
+ * The image from a file decoded into RAM once and drawn from the image cache
+ * @param scr pointer to the scene's screen
+ * @return 0: the images are compared by their times
+ */
+static uint32_t cached_create(lv_obj_t * scr)
+{
+    return img_scene_create(scr, "img_cached", file_path, true);
+}
+
+/**
+ * Drop the file from the image cache so the next refresh opens it again
+ * @param frame index of the next refresh
+ */
+static void file_update(uint32_t frame)
+{
+    (void) frame; /*Unused*/
+
+    /*The image object has its own copy of the path so drop everything. The scene has this image only.*/
+    lv_img_cache_invalidate_src(NULL);
+}
+
+/**
+ * Stop decoding into RAM when the image of the cached scene is deleted
+ * @param img pointer to the image
+ * @param event the current event
+ */
+static void cached_img_event_cb(lv_obj_t * img, lv_event_t event)
+{
+    (void) img; /*Unused*/
+
+    if(event == LV_EVENT_DELETE) decode_to_ram = false;
+}
+#endif
+
+/**
+ * Open the image once to measure its decoding and the memory it keeps in the cache,
+ * then fill the screen with it. The cache is cleared so the first refresh opens it again.
+ * @param scr pointer to the scene's screen
+ * @param name name of the scene
+ * @param src source of the image
+ * @param to_ram true: decode the file into RAM with the benchmark's decoder
+ * @return 0: the images are compared by their times
+ */
+static uint32_t img_scene_create(lv_obj_t * scr, const char * name, const void * src, bool to_ram)
+{
+    uint16_t id;
+    for(id = 0; strcmp(img_scenes[id].name, name) != 0; id++);
+
+#if LV_USE_FILESYSTEM
+    ram_drive_init();
+    decode_to_ram = to_ram;
+#else
+    (void) to_ram; /*Unused*/
+#endif
+
+    benchmark_img_result_t * res = &img_res[id];
+    memset(res, 0, sizeof(benchmark_img_result_t));
+
+    /*Start from an empty cache*/
+    lv_img_cache_invalidate_src(NULL);
+
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    uint32_t used_start = mon.total_size - mon.free_size;
+
+    uint64_t t = benchmark_get_time_ns();
+    lv_img_cache_entry_t * entry = lv_img_cache_open(src, &lv_style_plain);
+    res->decode_time = (uint32_t)((benchmark_get_time_ns() - t) / 1000);
+
+    lv_mem_monitor(&mon);
+    uint32_t used_end = mon.total_size - mon.free_size;
+    res->cache_mem = used_end > used_start ? used_end - used_start : 0;
+    img_res_valid[id] = entry ? true : false;
+
+    lv_img_cache_invalidate_src(NULL);
+
+    lv_obj_t * img = lv_img_create(scr, NULL);
+    lv_img_set_src(img, src);
+    lv_img_set_auto_size(img, false);
+    lv_obj_set_size(img, lv_disp_get_hor_res(NULL), lv_disp_get_ver_res(NULL));
+
+#if LV_USE_FILESYSTEM
+    /*Give the files back to the other decoders when the scene is deleted*/
+    if(to_ram) lv_obj_set_event_cb(img, cached_img_event_cb);
+#endif
+
+    return 0;
+}
+
+#if LV_USE_FILESYSTEM
+/**
+ * Register the RAM drive and the decoder which decodes the files into RAM. Only once.
+ */
+static void ram_drive_init(void)
+{
+    if(ram_decoder) return;
+
+    lv_fs_drv_init(&ram_drv);
+    ram_drv.letter = RAM_DRIVE_LETTER;
+    ram_drv.file_size = sizeof(ram_file_t);
+    ram_drv.open_cb = ram_open;
+    ram_drv.close_cb = ram_close;
+    ram_drv.read_cb = ram_read;
+    ram_drv.seek_cb = ram_seek;
+    ram_drv.tell_cb = ram_tell;
+    ram_drv.size_cb = ram_size;
+    lv_fs_drv_register(&ram_drv);
+
+    /*Created last so it's tried before the built-in decoder*/
+    ram_decoder = lv_img_decoder_create();
+    lv_img_decoder_set_info_cb(ram_decoder, ram_decoder_info);
+    lv_img_decoder_set_open_cb(ram_decoder, ram_decoder_open);
+    lv_img_decoder_set_close_cb(ram_decoder, ram_decoder_close);
+}
+
+/**
+ * Open the only file of the RAM drive: `benchmark_bg` in LittlevGL's binary image format
+ * @param drv pointer to the RAM drive
+ * @param file_p pointer to a `ram_file_t`
+ * @param path path of the file without the drive letter
+ * @param mode only reading is supported
+ * @return LV_FS_RES_OK or LV_FS_RES_NOT_EX if it's not the image
+ */
+static lv_fs_res_t ram_open(lv_fs_drv_t * drv, void * file_p, const char * path, lv_fs_mode_t mode)
+{
+    (void) drv; /*Unused*/
+
+    if(strcmp(path, RAM_FILE_NAME) != 0 || mode != LV_FS_MODE_RD) return LV_FS_RES_NOT_EX;
+
+    ((ram_file_t *)file_p)->pos = 0;
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Close a file of the RAM drive
+ * @param drv pointer to the RAM drive
+ * @param file_p pointer to a `ram_file_t`
+ * @return LV_FS_RES_OK
+ */
+static lv_fs_res_t ram_close(lv_fs_drv_t * drv, void * file_p)
+{
+    (void) drv;     /*Unused*/
+    (void) file_p;  /*Unused*/
+
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Read from the image file: the header of `benchmark_bg` followed by its pixels
+ * @param drv pointer to the RAM drive
+ * @param file_p pointer to a `ram_file_t`
+ * @param buf store the read bytes here
+ * @param btr number of bytes to read
+ * @param br store the number of read bytes here
+ * @return LV_FS_RES_OK
+ */
+static lv_fs_res_t ram_read(lv_fs_drv_t * drv, void * file_p, void * buf, uint32_t btr, uint32_t * br)
+{
+    (void) drv; /*Unused*/
+
+    ram_file_t * f = file_p;
+    uint8_t * buf8 = buf;
+    uint32_t hdr_size = sizeof(lv_img_header_t);
+    uint32_t size = hdr_size + benchmark_bg.data_size;
+
+    if(f->pos + btr > size) btr = f->pos < size ? size - f->pos : 0;
+    *br = btr;
+
+    /*The part from the header*/
+    if(f->pos < hdr_size) {
+        uint32_t len = LV_MATH_MIN(btr, hdr_size - f->pos);
+        memcpy(buf8, (const uint8_t *)&benchmark_bg.header + f->pos, len);
+        f->pos += len;
+        buf8 += len;
+        btr -= len;
+    }
+
+    /*The part from the pixels*/
+    memcpy(buf8, benchmark_bg.data + f->pos - hdr_size, btr);
+    f->pos += btr;
+
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Set the read position in a file of the RAM drive
+ * @param drv pointer to the RAM drive
+ * @param file_p pointer to a `ram_file_t`
+ * @param pos the new position in bytes
+ * @return LV_FS_RES_OK
+ */
+static lv_fs_res_t ram_seek(lv_fs_drv_t * drv, void * file_p, uint32_t pos)
+{
+    (void) drv; /*Unused*/
+
+    ((ram_file_t *)file_p)->pos = pos;
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Get the read position in a file of the RAM drive
+ * @param drv pointer to the RAM drive
+ * @param file_p pointer to a `ram_file_t`
+ * @param pos_p store the position here
+ * @return LV_FS_RES_OK
+ */
+static lv_fs_res_t ram_tell(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p)
+{
+    (void) drv; /*Unused*/
+
+    *pos_p = ((ram_file_t *)file_p)->pos;
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Get the size of the image file of the RAM drive
+ * @param drv pointer to the RAM drive
+ * @param file_p pointer to a `ram_file_t`
+ * @param size_p store the size here
+ * @return LV_FS_RES_OK
+ */
+static lv_fs_res_t ram_size(lv_fs_drv_t * drv, void * file_p, uint32_t * size_p)
+{
+    (void) drv;     /*Unused*/
+    (void) file_p;  /*Unused*/
+
+    *size_p = sizeof(lv_img_header_t) + benchmark_bg.data_size;
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Read the header of the file scenes' image if they decode into RAM. Other files are left to the other decoders.
+ * @param decoder pointer to the RAM decoder
+ * @param src the image source
+ * @param header store the header here
+ * @return LV_RES_OK: the RAM decoder takes the image; LV_RES_INV: let the other decoders try it
+ */
+static lv_res_t ram_decoder_info(lv_img_decoder_t * decoder, const void * src, lv_img_header_t * header)
+{
+    (void) decoder; /*Unused*/
+
+    if(decode_to_ram == false || lv_img_src_get_type(src) != LV_IMG_SRC_FILE) return LV_RES_INV;
+    if(strcmp(src, file_path) != 0) return LV_RES_INV;
+    if(strcmp(lv_fs_get_ext(src), "bin") != 0) return LV_RES_INV;
+
+    lv_fs_file_t f;
+    if(lv_fs_open(&f, src, LV_FS_MODE_RD) != LV_FS_RES_OK) return LV_RES_INV;
+
+    uint32_t br = 0;
+    lv_fs_res_t res = lv_fs_read(&f, header, sizeof(lv_img_header_t), &br);
+    lv_fs_close(&f);
+    if(res != LV_FS_RES_OK || br != sizeof(lv_img_header_t)) return LV_RES_INV;
+
+    /*Only the pixels are copied so only true color is supported*/
+    return header->cf == LV_IMG_CF_TRUE_COLOR ? LV_RES_OK : LV_RES_INV;
+}
+
+/**
+ * Read the whole image into RAM. The image cache keeps it until the image is invalidated or pushed out.
+ * @param decoder pointer to the RAM decoder
+ * @param dsc the decoder descriptor with the source and the header
+ * @return LV_RES_OK: `dsc->img_data` holds the pixels; LV_RES_INV: the file couldn't be read
+ */
+static lv_res_t ram_decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc)
+{
+    (void) decoder; /*Unused*/
+
+    lv_fs_file_t f;
+    if(lv_fs_open(&f, dsc->src, LV_FS_MODE_RD) != LV_FS_RES_OK) return LV_RES_INV;
+
+    uint32_t size = (uint32_t)dsc->header.w * dsc->header.h * LV_COLOR_SIZE / 8;
+    uint8_t * buf = lv_mem_alloc(size);
+    if(buf == NULL) {
+        lv_fs_close(&f);
+        return LV_RES_INV;
+    }
+
+    uint32_t br = 0;
+    lv_fs_seek(&f, sizeof(lv_img_header_t));
+    lv_fs_read(&f, buf, size, &br);
+    lv_fs_close(&f);
+
+    if(br != size) {
+        lv_mem_free(buf);
+        return LV_RES_INV;
+    }
+
+    dsc->img_data = buf;
+    return LV_RES_OK;
+}
+
+/**
+ * Free the decoded image
+ * @param decoder pointer to the RAM decoder
+ * @param dsc the decoder descriptor
+ */
+static void ram_decoder_close(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc)
+{
+    (void) decoder; /*Unused*/
+
+    if(dsc->img_data) {
+        lv_mem_free((void *)dsc->img_data);
+        dsc->img_data = NULL;
+    }
+}
+#endif /*LV_USE_FILESYSTEM*/
+
+#endif /*LV_USE_BENCHMARK*/
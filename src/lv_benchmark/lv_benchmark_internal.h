@@ -0,0 +1,106 @@
+/**
+ * @file lv_benchmark_internal.h
+ * Helpers shared by the files of the benchmark. Not part of its API.
+ */
+
+#ifndef BENCHMARK_INTERNAL_H
+#define BENCHMARK_INTERNAL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_benchmark.h"
+
+#if LV_USE_BENCHMARK
+
+/*********************
+ *      DEFINES
+ *********************/
+#define BENCHMARK_MEM_RESERVE   (16 * 1024)     /*Keep this much memory free for the rendering*/
+#define BENCHMARK_MEM_CHECK_MASK 0x3F           /*Check the memory after every 64 objects, tasks, etc. (it walks the heap)*/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Tell whether some more memory can be allocated.
+ * LittlevGL can't recover from running out of memory so it's better to not try.
+ * @param need the memory to allocate in bytes (25% is added for the fragmentation) or 0 to check only `BENCHMARK_MEM_RESERVE`
+ * @return true: probably enough (or can't be decided); false: surely not enough
+ */
+bool benchmark_mem_is_enough(uint64_t need);
+
+/**
+ * Integer square root for the standard deviations of the tests
+ * @param x a number
+ * @return the floor of the square root of `x`
+ */
+uint32_t benchmark_sqrt_u64(uint64_t x);
+
+/**
+ * Create the histogram chart with the percentile markers and the result table. Both are hidden until a result.
+ * @param page create them on this page
+ */
+void benchmark_result_view_create(lv_obj_t * page);
+
+/**
+ * Hide the histogram with its selector and the result table
+ */
+void benchmark_result_view_hide(void);
+
+/**
+ * Save the distribution of the refresh times to show it later
+ * @param id index of the scene or style
+ * @param samples the measured times
+ * @param cnt number of samples. 0: clear the histogram
+ * @param res the statistics of the samples (not used if `cnt` is 0)
+ */
+void benchmark_result_hist_save(uint16_t id, const uint32_t * samples, uint16_t cnt, const benchmark_result_t * res);
+
+/**
+ * Show a saved distribution of the refresh times on the histogram with the percentiles
+ * @param id index of the scene or style
+ */
+void benchmark_result_hist_show(uint16_t id);
+
+/**
+ * Show the drop down list to select the histogram of a scene or style and the histogram of the first one
+ * @param cnt number of saved histograms
+ * @param name_get function returning the name of a histogram by its index
+ */
+void benchmark_result_hist_picker_show(uint16_t cnt, const char * (*name_get)(uint16_t id));
+
+/**
+ * Get the result table to fill it with the result of a test
+ * @return pointer to the table
+ */
+lv_obj_t * benchmark_result_get_table(void);
+
+/**
+ * Set a name-value row of the result table
+ * @param row index of the row
+ * @param name text of the first column
+ * @param value text of the second column
+ */
+void benchmark_result_table_row_set(uint16_t row, const char * name, const char * value);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_BENCHMARK*/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* BENCHMARK_INTERNAL_H */
@@ -0,0 +1,465 @@
+/**
+ * @file lv_benchmark_obj.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_benchmark_internal.h"
+#if LV_USE_BENCHMARK
+
+#include <stdio.h>
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define OBJ_COL_NUM     8
+#define OBJ_H           (LV_DPI / 3)
+#define LAYOUT_REPEAT   8           /*Repeat the layout changes to average them*/
+#define STYLE_REPEAT    8           /*Repeat the style changes to average them*/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static lv_obj_t * obj_page_create(lv_obj_t * scr, uint32_t num, lv_style_t * btn_style);
+static lv_obj_t * layout_page_create(lv_obj_t * scr, uint32_t num);
+static lv_obj_t * layout_btn_create(lv_obj_t * page, uint32_t id);
+static uint32_t mem_used_get(lv_mem_monitor_t * mon);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static const uint32_t def_nums[] = {10, 100, 1000, 10000};
+static benchmark_obj_result_t obj_res[BENCHMARK_OBJ_RUN_MAX];
+static uint16_t obj_res_cnt;
+static const uint32_t def_layout_nums[] = {10, 50, 100, 500, 1000, 2000};
+static benchmark_layout_result_t layout_res[BENCHMARK_OBJ_RUN_MAX];
+static uint16_t layout_res_cnt;
+static benchmark_style_mod_result_t style_mod_res[BENCHMARK_OBJ_RUN_MAX];
+static uint16_t style_mod_res_cnt;
+static lv_style_t style_shared;
+static lv_style_t style_unused;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Measure how the cost of the objects scales with their number.
+ * For each number a page with that many buttons (each with a label) is created on a new screen,
+ * rendered once and deleted. The time of each step and the used memory are saved.
+ * It runs synchronously and leaves the original screen loaded.
+ * A number is skipped if it wouldn't fit into the memory according to the smaller numbers.
+ * @param nums the number of buttons to try in increasing order or NULL to use 10, 100, 1000, 10000
+ * @param cnt number of elements in `nums`. Limited to `BENCHMARK_OBJ_RUN_MAX`.
+ */
+void benchmark_run_obj_scaling(const uint32_t * nums, uint16_t cnt)
+{
+    if(nums == NULL) {
+        nums = def_nums;
+        cnt = sizeof(def_nums) / sizeof(def_nums[0]);
+    }
+    if(cnt > BENCHMARK_OBJ_RUN_MAX) cnt = BENCHMARK_OBJ_RUN_MAX;
+
+    lv_disp_t * disp = lv_disp_get_default();
+    lv_obj_t * old_scr = lv_disp_get_scr_act(disp);
+    uint32_t mem_per_obj = 0;
+
+    obj_res_cnt = 0;
+    uint16_t i;
+    for(i = 0; i < cnt; i++) {
+        benchmark_obj_result_t * res = &obj_res[obj_res_cnt];
+        memset(res, 0, sizeof(benchmark_obj_result_t));
+        res->obj_num = nums[i];
+        obj_res_cnt++;
+
+        if(benchmark_mem_is_enough((uint64_t)nums[i] * mem_per_obj) == false) {
+            res->skipped = true;
+            continue;
+        }
+
+        lv_mem_monitor_t mon;
+        uint32_t used_start = mem_used_get(&mon);
+
+        /*Create*/
+        uint64_t t = benchmark_get_time_ns();
+        lv_obj_t * scr = lv_obj_create(NULL, NULL);
+        obj_page_create(scr, nums[i], NULL);
+        res->create_time = (uint32_t)((benchmark_get_time_ns() - t) / 1000);
+
+        uint32_t used_obj = mem_used_get(&mon);
+        res->mem_used = used_obj > used_start ? used_obj - used_start : 0;
+        res->mem_per_obj = nums[i] ? res->mem_used / nums[i] : 0;
+        res->frag_pct = mon.frag_pct;
+        mem_per_obj = res->mem_per_obj;
+
+        /*Render the first time*/
+        lv_disp_load_scr(scr);
+        t = benchmark_get_time_ns();
+        lv_refr_now(disp);
+        res->render_time = (uint32_t)((benchmark_get_time_ns() - t) / 1000);
+
+        /*Delete*/
+        lv_disp_load_scr(old_scr);
+        t = benchmark_get_time_ns();
+        lv_obj_del(scr);
+        res->del_time = (uint32_t)((benchmark_get_time_ns() - t) / 1000);
+
+        uint32_t used_end = mem_used_get(&mon);
+        res->mem_leak = used_end > used_start ? used_end - used_start : 0;
+    }
+
+    lv_obj_invalidate(old_scr);
+}
+
+/**
+ * Get the number of results of `benchmark_run_obj_scaling()`
+ * @return number of results
+ */
+uint16_t benchmark_get_obj_cnt(void)
+{
+    return obj_res_cnt;
+}
+
+/**
+ * Get a result of `benchmark_run_obj_scaling()`
+ * @param id index of the result
+ * @return pointer to the result or NULL if `id` is invalid
+ */
+const benchmark_obj_result_t * benchmark_get_obj_result(uint16_t id)
+{
+    if(id >= obj_res_cnt) return NULL;
+
+    return &obj_res[id];
+}
+
+/**
+ * Measure the re-layout of a page with `LV_LAYOUT_PRETTY` (like the benchmark's own page) for different numbers of children.
+ * For each number a page with that many buttons is created and the following are measured (averaged on a few repeats):
+ * - fit: recalculating the size of the scrollable only (setting `LV_LAYOUT_OFF`)
+ * - layout: rearranging the children (setting `LV_LAYOUT_PRETTY` minus the fit)
+ * - resize, add, delete: changing the page's width, adding a button, deleting a button (with the re-layout they cause)
+ * - draw: refreshing the screen after a resize
+ * It runs synchronously and leaves the original screen loaded.
+ * @param nums the number of buttons to try in increasing order or NULL to use 10, 50, 100, 500, 1000, 2000
+ * @param cnt number of elements in `nums`. Limited to `BENCHMARK_OBJ_RUN_MAX`.
+ */
+void benchmark_run_layout(const uint32_t * nums, uint16_t cnt)
+{
+    if(nums == NULL) {
+        nums = def_layout_nums;
+        cnt = sizeof(def_layout_nums) / sizeof(def_layout_nums[0]);
+    }
+    if(cnt > BENCHMARK_OBJ_RUN_MAX) cnt = BENCHMARK_OBJ_RUN_MAX;
+
+    lv_disp_t * disp = lv_disp_get_default();
+    lv_obj_t * old_scr = lv_disp_get_scr_act(disp);
+    lv_coord_t hres = lv_disp_get_hor_res(NULL);
+    uint32_t mem_per_obj = 0;
+
+    layout_res_cnt = 0;
+    uint16_t i;
+    for(i = 0; i < cnt; i++) {
+        benchmark_layout_result_t * res = &layout_res[layout_res_cnt];
+        memset(res, 0, sizeof(benchmark_layout_result_t));
+        res->obj_num = nums[i];
+        layout_res_cnt++;
+
+        if(benchmark_mem_is_enough((uint64_t)nums[i] * mem_per_obj) == false) {
+            res->skipped = true;
+            continue;
+        }
+
+        lv_mem_monitor_t mon;
+        uint32_t used_start = mem_used_get(&mon);
+
+        lv_obj_t * scr = lv_obj_create(NULL, NULL);
+        lv_disp_load_scr(scr);
+
+        uint64_t t = benchmark_get_time_ns();
+        lv_obj_t * page = layout_page_create(scr, nums[i]);
+        res->build_time = (uint32_t)((benchmark_get_time_ns() - t) / 1000);
+
+        uint32_t used_obj = mem_used_get(&mon);
+        mem_per_obj = used_obj > used_start && nums[i] ? (used_obj - used_start) / nums[i] : 0;
+
+        /*Draw once to not measure the first drawing*/
+        lv_refr_now(disp);
+
+        uint64_t fit_sum = 0;
+        uint64_t layout_fit_sum = 0;
+        uint64_t resize_sum = 0;
+        uint64_t draw_sum = 0;
+        uint64_t add_sum = 0;
+        uint64_t del_sum = 0;
+        uint16_t rep;
+        for(rep = 0; rep < LAYOUT_REPEAT; rep++) {
+            /*Only the fit is recalculated when the layout is turned off*/
+            t = benchmark_get_time_ns();
+            lv_page_set_scrl_layout(page, LV_LAYOUT_OFF);
+            fit_sum += benchmark_get_time_ns() - t;
+
+            t = benchmark_get_time_ns();
+            lv_page_set_scrl_layout(page, LV_LAYOUT_PRETTY);
+            layout_fit_sum += benchmark_get_time_ns() - t;
+
+            t = benchmark_get_time_ns();
+            lv_obj_set_width(page, rep & 0x1 ? hres : (hres * 3) / 4);
+            resize_sum += benchmark_get_time_ns() - t;
+
+            t = benchmark_get_time_ns();
+            lv_refr_now(disp);
+            draw_sum += benchmark_get_time_ns() - t;
+
+            t = benchmark_get_time_ns();
+            lv_obj_t * btn = layout_btn_create(page, nums[i] + rep);
+            add_sum += benchmark_get_time_ns() - t;
+
+            t = benchmark_get_time_ns();
+            lv_obj_del(btn);
+            del_sum += benchmark_get_time_ns() - t;
+        }
+
+        res->fit_time = (uint32_t)(fit_sum / 1000 / LAYOUT_REPEAT);
+        res->layout_time = layout_fit_sum > fit_sum ? (uint32_t)((layout_fit_sum - fit_sum) / 1000 / LAYOUT_REPEAT) : 0;
+        res->resize_time = (uint32_t)(resize_sum / 1000 / LAYOUT_REPEAT);
+        res->draw_time = (uint32_t)(draw_sum / 1000 / LAYOUT_REPEAT);
+        res->add_time = (uint32_t)(add_sum / 1000 / LAYOUT_REPEAT);
+        res->del_time = (uint32_t)(del_sum / 1000 / LAYOUT_REPEAT);
+
+        lv_disp_load_scr(old_scr);
+        lv_obj_del(scr);
+    }
+
+    lv_obj_invalidate(old_scr);
+}
+
+/**
+ * Get the number of results of `benchmark_run_layout()`
+ * @return number of results
+ */
+uint16_t benchmark_get_layout_cnt(void)
+{
+    return layout_res_cnt;
+}
+
+/**
+ * Get a result of `benchmark_run_layout()`
+ * @param id index of the result
+ * @return pointer to the result or NULL if `id` is invalid
+ */
+const benchmark_layout_result_t * benchmark_get_layout_result(uint16_t id)
+{
+    if(id >= layout_res_cnt) return NULL;
+
+    return &layout_res[id];
+}
+
+/**
+ * Measure the cost of modifying a style which is shared by many objects (like the styles of a theme).
+ * For each number a page with that many buttons using the same style is created
+ * and the color of the style is changed a few times. The following are measured (averaged on the repeats):
+ * - walk: `lv_obj_report_style_mod()` with a style which is not used by any object. It only visits every object.
+ * - propagate: `lv_obj_report_style_mod()` with the shared style minus the walk (refreshing and invalidating the users)
+ * - draw: refreshing the screen after the change
+ * It runs synchronously and leaves the original screen loaded.
+ * @param nums the number of buttons to try in increasing order or NULL to use 10, 100, 1000, 10000
+ * @param cnt number of elements in `nums`. Limited to `BENCHMARK_OBJ_RUN_MAX`.
+ */
+void benchmark_run_style_mod(const uint32_t * nums, uint16_t cnt)
+{
+    if(nums == NULL) {
+        nums = def_nums;
+        cnt = sizeof(def_nums) / sizeof(def_nums[0]);
+    }
+    if(cnt > BENCHMARK_OBJ_RUN_MAX) cnt = BENCHMARK_OBJ_RUN_MAX;
+
+    lv_disp_t * disp = lv_disp_get_default();
+    lv_obj_t * old_scr = lv_disp_get_scr_act(disp);
+    uint32_t mem_per_obj = 0;
+
+    lv_style_copy(&style_shared, &lv_style_btn_rel);
+    lv_style_copy(&style_unused, &lv_style_btn_rel);
+
+    style_mod_res_cnt = 0;
+    uint16_t i;
+    for(i = 0; i < cnt; i++) {
+        benchmark_style_mod_result_t * res = &style_mod_res[style_mod_res_cnt];
+        memset(res, 0, sizeof(benchmark_style_mod_result_t));
+        res->obj_num = nums[i];
+        style_mod_res_cnt++;
+
+        if(benchmark_mem_is_enough((uint64_t)nums[i] * mem_per_obj) == false) {
+            res->skipped = true;
+            continue;
+        }
+
+        lv_mem_monitor_t mon;
+        uint32_t used_start = mem_used_get(&mon);
+
+        lv_obj_t * scr = lv_obj_create(NULL, NULL);
+        obj_page_create(scr, nums[i], &style_shared);
+        lv_disp_load_scr(scr);
+
+        uint32_t used_obj = mem_used_get(&mon);
+        mem_per_obj = used_obj > used_start && nums[i] ? (used_obj - used_start) / nums[i] : 0;
+
+        /*Draw once to not measure the first drawing*/
+        lv_refr_now(disp);
+
+        uint64_t walk_sum = 0;
+        uint64_t mod_sum = 0;
+        uint64_t draw_sum = 0;
+        uint16_t rep;
+        for(rep = 0; rep < STYLE_REPEAT; rep++) {
+            /*Nothing uses this style so only the objects are visited*/
+            uint64_t t = benchmark_get_time_ns();
+            lv_obj_report_style_mod(&style_unused);
+            walk_sum += benchmark_get_time_ns() - t;
+
+            /*Change the color like a theme switch*/
+            style_shared.body.main_color = rep & 0x1 ? lv_style_btn_rel.body.main_color : LV_COLOR_MAKE(0x30, 0x90, 0x30);
+            style_shared.body.grad_color = rep & 0x1 ? lv_style_btn_rel.body.grad_color : LV_COLOR_MAKE(0x20, 0x60, 0x20);
+
+            t = benchmark_get_time_ns();
+            lv_obj_report_style_mod(&style_shared);
+            mod_sum += benchmark_get_time_ns() - t;
+
+            t = benchmark_get_time_ns();
+            lv_refr_now(disp);
+            draw_sum += benchmark_get_time_ns() - t;
+        }
+
+        res->walk_time = (uint32_t)(walk_sum / 1000 / STYLE_REPEAT);
+        res->propagate_time = mod_sum > walk_sum ? (uint32_t)((mod_sum - walk_sum) / 1000 / STYLE_REPEAT) : 0;
+        res->draw_time = (uint32_t)(draw_sum / 1000 / STYLE_REPEAT);
+
+        lv_disp_load_scr(old_scr);
+        lv_obj_del(scr);
+    }
+
+    lv_obj_invalidate(old_scr);
+}
+
+/**
+ * Get the number of results of `benchmark_run_style_mod()`
+ * @return number of results
+ */
+uint16_t benchmark_get_style_mod_cnt(void)
+{
+    return style_mod_res_cnt;
+}
+
+/**
+ * Get a result of `benchmark_run_style_mod()`
+ * @param id index of the result
+ * @return pointer to the result or NULL if `id` is invalid
+ */
+const benchmark_style_mod_result_t * benchmark_get_style_mod_result(uint16_t id)
+{
+    if(id >= style_mod_res_cnt) return NULL;
+
+    return &style_mod_res[id];
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Create a page with buttons in a grid. No layout and fit is used to measure the objects only.
+ * @param scr parent of the page
+ * @param num number of buttons
+ * @param btn_style released style of the buttons or NULL to use the theme's
+ * @return pointer to the page
+ */
+static lv_obj_t * obj_page_create(lv_obj_t * scr, uint32_t num, lv_style_t * btn_style)
+{
+    lv_coord_t hres = lv_disp_get_hor_res(NULL);
+    lv_coord_t vres = lv_disp_get_ver_res(NULL);
+    lv_coord_t w = hres / OBJ_COL_NUM;
+    uint32_t row_num = (num + OBJ_COL_NUM - 1) / OBJ_COL_NUM;
+
+    lv_obj_t * page = lv_page_create(scr, NULL);
+    lv_obj_set_size(page, hres, vres);
+    lv_page_set_scrl_fit(page, LV_FIT_NONE);
+    lv_obj_set_size(lv_page_get_scrl(page), hres, (lv_coord_t)LV_MATH_MIN(row_num * OBJ_H, (uint32_t)LV_COORD_MAX));
+
+    uint32_t i;
+    for(i = 0; i < num; i++) {
+        lv_obj_t * btn = lv_btn_create(page, NULL);
+        lv_obj_set_size(btn, w, OBJ_H);
+        lv_obj_set_pos(btn, (i % OBJ_COL_NUM) * w, (lv_coord_t)LV_MATH_MIN((i / OBJ_COL_NUM) * OBJ_H, (uint32_t)LV_COORD_MAX));
+        if(btn_style) lv_btn_set_style(btn, LV_BTN_STYLE_REL, btn_style);
+
+        char buf[16];
+        sprintf(buf, "%d", (int)i);
+        lv_obj_t * label = lv_label_create(btn, NULL);
+        lv_label_set_text(label, buf);
+    }
+
+    return page;
+}
+
+/**
+ * Create a scrollable page with `LV_LAYOUT_PRETTY` and buttons on it like the benchmark's own page
+ * @param scr parent of the page
+ * @param num number of buttons
+ * @return pointer to the page
+ */
+static lv_obj_t * layout_page_create(lv_obj_t * scr, uint32_t num)
+{
+    lv_obj_t * page = lv_page_create(scr, NULL);
+    lv_obj_set_size(page, lv_disp_get_hor_res(NULL), lv_disp_get_ver_res(NULL));
+    lv_page_set_scrl_layout(page, LV_LAYOUT_PRETTY);
+
+    uint32_t i;
+    for(i = 0; i < num; i++) {
+        layout_btn_create(page, i);
+    }
+
+    return page;
+}
+
+/**
+ * Add a button with a label to a page. Its size is set by its label.
+ * @param page pointer to a page
+ * @param id written on the label
+ * @return pointer to the button
+ */
+static lv_obj_t * layout_btn_create(lv_obj_t * page, uint32_t id)
+{
+    lv_obj_t * btn = lv_btn_create(page, NULL);
+    lv_btn_set_fit(btn, LV_FIT_TIGHT);
+
+    char buf[16];
+    sprintf(buf, "Item %d", (int)id);
+    lv_obj_t * label = lv_label_create(btn, NULL);
+    lv_label_set_text(label, buf);
+
+    return btn;
+}
+
+/**
+ * Get the used memory of LittlevGL
+ * @param mon store the whole memory monitor here
+ * @return used memory in bytes (0 with `LV_MEM_CUSTOM`)
+ */
+static uint32_t mem_used_get(lv_mem_monitor_t * mon)
+{
+    lv_mem_monitor(mon);
+
+    return mon->total_size - mon->free_size;
+}
+
+#endif /*LV_USE_BENCHMARK*/
@@ -0,0 +1,252 @@
+/**
+ * @file lv_benchmark_result.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_benchmark_internal.h"
+#if LV_USE_BENCHMARK
+
+#include <stdio.h>
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define HIST_BIN_NUM    20      /*Columns of the frame time histogram*/
+#define HIST_MARKER_NUM 3       /*p50, p95, p99*/
+#define HIST_RES_MAX    (BENCHMARK_SCENE_MAX > BENCHMARK_STYLE_NUM ? BENCHMARK_SCENE_MAX : BENCHMARK_STYLE_NUM)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+/*The frame time histogram of a result to show it later*/
+typedef struct {
+    lv_coord_t bins[HIST_BIN_NUM];
+    uint32_t min;
+    uint32_t max;
+    uint32_t ps[HIST_MARKER_NUM];   /*p50, p95, p99*/
+} hist_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void hist_picker_event_cb(lv_obj_t * ddlist, lv_event_t event);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_obj_t * hist_picker;      /*Drop down list to select the histogram of a scene or style*/
+static lv_obj_t * hist_chart;
+static lv_chart_series_t * hist_ser;
+static hist_t hist_res[HIST_RES_MAX];   /*Histograms of the scenes or styles of the last run*/
+static lv_obj_t * hist_markers[HIST_MARKER_NUM];
+static lv_obj_t * hist_marker_labels[HIST_MARKER_NUM];
+static lv_point_t hist_marker_points[HIST_MARKER_NUM][2];
+static lv_obj_t * result_table;
+
+static lv_style_t style_marker[HIST_MARKER_NUM];
+static lv_style_t style_table_head;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Create the histogram chart with the percentile markers and the result table. Both are hidden until a result.
+ * @param page create them on this page
+ */
+void benchmark_result_view_create(lv_obj_t * page)
+{
+    lv_coord_t w = lv_page_get_fit_width(page);
+
+    hist_picker = lv_ddlist_create(page, NULL);
+    lv_ddlist_set_fix_width(hist_picker, w);
+    lv_obj_set_event_cb(hist_picker, hist_picker_event_cb);
+
+    hist_chart = lv_chart_create(page, NULL);
+    lv_obj_set_size(hist_chart, w, lv_disp_get_ver_res(NULL) / 3);
+    lv_chart_set_type(hist_chart, LV_CHART_TYPE_COLUMN);
+    lv_chart_set_point_count(hist_chart, HIST_BIN_NUM);
+    lv_chart_set_div_line_count(hist_chart, 3, 0);
+    hist_ser = lv_chart_add_series(hist_chart, LV_COLOR_BLUE);
+
+    /*Vertical lines on the p50, p95 and p99 refresh times*/
+    static const char * marker_txts[] = {"p50", "p95", "p99"};
+    lv_color_t marker_colors[HIST_MARKER_NUM] = {LV_COLOR_GREEN, LV_COLOR_ORANGE, LV_COLOR_RED};
+    uint8_t i;
+    for(i = 0; i < HIST_MARKER_NUM; i++) {
+        lv_style_copy(&style_marker[i], &lv_style_plain);
+        style_marker[i].line.color = marker_colors[i];
+        style_marker[i].line.width = 2;
+        style_marker[i].text.color = marker_colors[i];
+
+        hist_markers[i] = lv_line_create(hist_chart, NULL);
+        lv_line_set_style(hist_markers[i], LV_LINE_STYLE_MAIN, &style_marker[i]);
+
+        hist_marker_labels[i] = lv_label_create(hist_chart, NULL);
+        lv_label_set_style(hist_marker_labels[i], LV_LABEL_STYLE_MAIN, &style_marker[i]);
+        lv_label_set_text(hist_marker_labels[i], marker_txts[i]);
+    }
+
+    lv_style_copy(&style_table_head, &lv_style_plain_color);
+
+    result_table = lv_table_create(page, NULL);
+    lv_table_set_style(result_table, LV_TABLE_STYLE_CELL2, &style_table_head);
+
+    benchmark_result_view_hide();
+}
+
+/**
+ * Hide the histogram with its selector and the result table
+ */
+void benchmark_result_view_hide(void)
+{
+    lv_obj_set_hidden(hist_picker, true);
+    lv_obj_set_hidden(hist_chart, true);
+    lv_obj_set_hidden(result_table, true);
+}
+
+/**
+ * Save the distribution of the refresh times to show it later
+ * @param id index of the scene or style
+ * @param samples the measured times
+ * @param cnt number of samples. 0: clear the histogram
+ * @param res the statistics of the samples (not used if `cnt` is 0)
+ */
+void benchmark_result_hist_save(uint16_t id, const uint32_t * samples, uint16_t cnt, const benchmark_result_t * res)
+{
+    if(id >= HIST_RES_MAX) return;
+
+    hist_t * hist = &hist_res[id];
+    if(cnt == 0) {
+        memset(hist, 0, sizeof(hist_t));
+        return;
+    }
+
+    /*The columns cover min..max evenly*/
+    uint32_t range = res->max - res->min + 1;
+
+    uint16_t i;
+    for(i = 0; i < HIST_BIN_NUM; i++) hist->bins[i] = 0;
+
+    for(i = 0; i < cnt; i++) {
+        uint32_t bin = (uint32_t)((uint64_t)(samples[i] - res->min) * HIST_BIN_NUM / range);
+        hist->bins[bin]++;
+    }
+
+    hist->min = res->min;
+    hist->max = res->max;
+    hist->ps[0] = res->p50;
+    hist->ps[1] = res->p95;
+    hist->ps[2] = res->p99;
+}
+
+/**
+ * Show a saved distribution of the refresh times on the histogram with the percentiles
+ * @param id index of the scene or style
+ */
+void benchmark_result_hist_show(uint16_t id)
+{
+    if(id >= HIST_RES_MAX) return;
+
+    hist_t * hist = &hist_res[id];
+    uint32_t range = hist->max - hist->min + 1;
+
+    lv_coord_t y_max = 1;
+    uint16_t i;
+    for(i = 0; i < HIST_BIN_NUM; i++) {
+        if(hist->bins[i] > y_max) y_max = hist->bins[i];
+    }
+
+    lv_chart_set_range(hist_chart, 0, y_max);
+    lv_chart_set_points(hist_chart, hist_ser, hist->bins);
+
+    /*Column `i` is centered at (i + 0.5) / HIST_BIN_NUM of the width so a time maps linearly to x*/
+    lv_coord_t w = lv_obj_get_width(hist_chart);
+    lv_coord_t h = lv_obj_get_height(hist_chart);
+    const lv_font_t * font = lv_obj_get_style(hist_marker_labels[0])->text.font;
+    for(i = 0; i < HIST_MARKER_NUM; i++) {
+        lv_coord_t x = (lv_coord_t)((uint64_t)(hist->ps[i] - hist->min) * w / range);
+        hist_marker_points[i][0].x = x;
+        hist_marker_points[i][0].y = 0;
+        hist_marker_points[i][1].x = x;
+        hist_marker_points[i][1].y = h;
+        lv_line_set_points(hist_markers[i], hist_marker_points[i], 2);
+
+        /*Put the labels under each other as the percentiles can be close*/
+        lv_obj_set_pos(hist_marker_labels[i], x + 2, i * lv_font_get_line_height(font));
+    }
+
+    lv_obj_set_hidden(hist_chart, false);
+}
+
+/**
+ * Show the drop down list to select the histogram of a scene or style and the histogram of the first one
+ * @param cnt number of saved histograms
+ * @param name_get function returning the name of a histogram by its index
+ */
+void benchmark_result_hist_picker_show(uint16_t cnt, const char * (*name_get)(uint16_t id))
+{
+    if(cnt == 0) return;
+
+    char buf[HIST_RES_MAX * 32];
+    uint32_t len = 0;
+    uint16_t i;
+    for(i = 0; i < cnt; i++) {
+        len += snprintf(&buf[len], sizeof(buf) - len, "%s%s", i == 0 ? "" : "\n", name_get(i));
+        if(len >= sizeof(buf)) break;
+    }
+
+    lv_ddlist_set_options(hist_picker, buf);
+    lv_ddlist_set_selected(hist_picker, 0);
+    lv_obj_set_hidden(hist_picker, false);
+    benchmark_result_hist_show(0);
+}
+
+/**
+ * Get the result table to fill it with the result of a test
+ * @return pointer to the table
+ */
+lv_obj_t * benchmark_result_get_table(void)
+{
+    return result_table;
+}
+
+/**
+ * Set a name-value row of the result table
+ * @param row index of the row
+ * @param name text of the first column
+ * @param value text of the second column
+ */
+void benchmark_result_table_row_set(uint16_t row, const char * name, const char * value)
+{
+    lv_table_set_cell_value(result_table, row, 0, name);
+    lv_table_set_cell_type(result_table, row, 0, 2);
+    lv_table_set_cell_value(result_table, row, 1, value);
+    lv_table_set_cell_type(result_table, row, 1, 1);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Called when a scene or style is selected on the drop down list. Shows its histogram.
+ * @param ddlist pointer to the drop down list
+ * @param event the current event
+ */
+static void hist_picker_event_cb(lv_obj_t * ddlist, lv_event_t event)
+{
+    if(event != LV_EVENT_VALUE_CHANGED) return;
+
+    benchmark_result_hist_show(lv_ddlist_get_selected(ddlist));
+}
+
+#endif /*LV_USE_BENCHMARK*/
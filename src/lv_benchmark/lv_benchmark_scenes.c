@@ -0,0 +1,446 @@
+/**
+ * @file lv_benchmark_scenes.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_benchmark.h"
+#if LV_USE_BENCHMARK
+
+/*********************
+ *      DEFINES
+ *********************/
+#define GRID_COL        4
+#define GRID_ROW        4
+#define GRID_GAP        (LV_DPI / 20)
+#define RADIUS          (LV_DPI / 5)
+#define BORDER_WIDTH    (LV_DPI / 20)
+#define SHADOW_S        (LV_DPI / 20)
+#define SHADOW_M        (LV_DPI / 8)
+#define SHADOW_L        (LV_DPI / 4)
+#define SHADOW_OBJ_MIN  (LV_DPI / 10)   /*Make the shadow narrower on small screens to keep the objects this large*/
+#define IMG_RECOLOR     LV_OPA_50
+#define OPACITY         LV_OPA_50
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static uint32_t empty_create(lv_obj_t * scr);
+static uint32_t rect_create(lv_obj_t * scr);
+static uint32_t grad_create(lv_obj_t * scr);
+static uint32_t radius_create(lv_obj_t * scr);
+static uint32_t border_create(lv_obj_t * scr);
+static uint32_t shadow_s_create(lv_obj_t * scr);
+static uint32_t shadow_m_create(lv_obj_t * scr);
+static uint32_t shadow_l_create(lv_obj_t * scr);
+static uint32_t img_create(lv_obj_t * scr);
+static uint32_t img_recolor_create(lv_obj_t * scr);
+static uint32_t opa_create(lv_obj_t * scr);
+#if LV_FONT_ROBOTO_12
+static uint32_t text_12_create(lv_obj_t * scr);
+#endif
+#if LV_FONT_ROBOTO_16
+static uint32_t text_16_create(lv_obj_t * scr);
+#endif
+#if LV_FONT_ROBOTO_22
+static uint32_t text_22_create(lv_obj_t * scr);
+#endif
+#if LV_FONT_ROBOTO_28
+static uint32_t text_28_create(lv_obj_t * scr);
+#endif
+static uint32_t grid_create(lv_obj_t * scr, const lv_style_t * style, lv_coord_t margin);
+static uint32_t shadow_create(lv_obj_t * scr, lv_style_t * style, lv_coord_t width);
+static uint32_t img_fill_create(lv_obj_t * scr, const lv_style_t * style);
+static uint32_t text_create(lv_obj_t * scr, lv_style_t * style, const lv_font_t * font);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_style_t style_rect;
+static lv_style_t style_grad;
+static lv_style_t style_radius;
+static lv_style_t style_border;
+static lv_style_t style_shadow_s;
+static lv_style_t style_shadow_m;
+static lv_style_t style_shadow_l;
+static lv_style_t style_img;
+static lv_style_t style_img_recolor;
+static lv_style_t style_opa;
+#if LV_FONT_ROBOTO_12
+static lv_style_t style_text_12;
+#endif
+#if LV_FONT_ROBOTO_16
+static lv_style_t style_text_16;
+#endif
+#if LV_FONT_ROBOTO_22
+static lv_style_t style_text_22;
+#endif
+#if LV_FONT_ROBOTO_28
+static lv_style_t style_text_28;
+#endif
+
+static const benchmark_scene_t prim_scenes[] = {
+    {"empty", empty_create, NULL},
+    {"rect", rect_create, NULL},
+    {"gradient", grad_create, NULL},
+    {"radius", radius_create, NULL},
+    {"border", border_create, NULL},
+    {"shadow_s", shadow_s_create, NULL},
+    {"shadow_m", shadow_m_create, NULL},
+    {"shadow_l", shadow_l_create, NULL},
+    {"img", img_create, NULL},
+    {"img_recolor", img_recolor_create, NULL},
+    {"opa", opa_create, NULL},
+#if LV_FONT_ROBOTO_12
+    {"text_12", text_12_create, NULL},
+#endif
+#if LV_FONT_ROBOTO_16
+    {"text_16", text_16_create, NULL},
+#endif
+#if LV_FONT_ROBOTO_22
+    {"text_22", text_22_create, NULL},
+#endif
+#if LV_FONT_ROBOTO_28
+    {"text_28", text_28_create, NULL},
+#endif
+};
+
+static const char * lorem_txt =
+    "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt ut labore et "
+    "dolore magna aliqua. Ut enim ad minim veniam, quis nostrud exercitation ullamco laboris nisi ut aliquip "
+    "ex ea commodo consequat. Duis aute irure dolor in reprehenderit in voluptate velit esse cillum dolore eu "
+    "fugiat nulla pariatur. Excepteur sint occaecat cupidatat non proident, sunt in culpa qui officia deserunt "
+    "mollit anim id est laborum. Sed ut perspiciatis unde omnis iste natus error sit voluptatem accusantium "
+    "doloremque laudantium, totam rem aperiam, eaque ipsa quae ab illo inventore veritatis et quasi architecto "
+    "beatae vitae dicta sunt explicabo. Nemo enim ipsam voluptatem quia voluptas sit aspernatur aut odit aut "
+    "fugit, sed quia consequuntur magni dolores eos qui ratione voluptatem sequi nesciunt.";
+
+LV_IMG_DECLARE(benchmark_bg)
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Get the scenes which measure one drawing primitive each (rectangle, gradient, shadow, image, text, etc.)
+ * @param cnt store the number of scenes here
+ * @return the array of scenes. The first is an empty screen.
+ */
+const benchmark_scene_t * benchmark_get_prim_scenes(uint16_t * cnt)
+{
+    *cnt = sizeof(prim_scenes) / sizeof(prim_scenes[0]);
+    return prim_scenes;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Only the screen's background
+ * @param scr pointer to the scene's screen
+ * @return 0: the empty scene is the baseline
+ */
+static uint32_t empty_create(lv_obj_t * scr)
+{
+    (void) scr; /*Unused*/
+
+    return 0;
+}
+
+/**
+ * Plain, opaque rectangles
+ * @param scr pointer to the scene's screen
+ * @return the area of the rectangles
+ */
+static uint32_t rect_create(lv_obj_t * scr)
+{
+    lv_style_copy(&style_rect, &lv_style_plain_color);
+    style_rect.body.radius = 0;
+
+    return grid_create(scr, &style_rect, GRID_GAP);
+}
+
+/**
+ * Rectangles with vertical gradient
+ * @param scr pointer to the scene's screen
+ * @return the area of the rectangles
+ */
+static uint32_t grad_create(lv_obj_t * scr)
+{
+    lv_style_copy(&style_grad, &lv_style_plain_color);
+    style_grad.body.radius = 0;
+    style_grad.body.main_color = LV_COLOR_BLUE;
+    style_grad.body.grad_color = LV_COLOR_RED;
+
+    return grid_create(scr, &style_grad, GRID_GAP);
+}
+
+/**
+ * Rectangles with rounded corners
+ * @param scr pointer to the scene's screen
+ * @return the area of the rectangles
+ */
+static uint32_t radius_create(lv_obj_t * scr)
+{
+    lv_style_copy(&style_radius, &lv_style_plain_color);
+    style_radius.body.radius = RADIUS;
+
+    return grid_create(scr, &style_radius, GRID_GAP);
+}
+
+/**
+ * Transparent rectangles with border only
+ * @param scr pointer to the scene's screen
+ * @return the area of the rectangles
+ */
+static uint32_t border_create(lv_obj_t * scr)
+{
+    lv_style_copy(&style_border, &lv_style_plain_color);
+    style_border.body.radius = 0;
+    style_border.body.opa = LV_OPA_TRANSP;
+    style_border.body.border.width = BORDER_WIDTH;
+    style_border.body.border.color = LV_COLOR_BLACK;
+    style_border.body.border.opa = LV_OPA_COVER;
+
+    return grid_create(scr, &style_border, GRID_GAP);
+}
+
+/**
+ * Rectangles with small shadow
+ * @param scr pointer to the scene's screen
+ * @return the area of the rectangles with their shadow
+ */
+static uint32_t shadow_s_create(lv_obj_t * scr)
+{
+    return shadow_create(scr, &style_shadow_s, SHADOW_S);
+}
+
+/**
+ * Rectangles with medium shadow
+ * @param scr pointer to the scene's screen
+ * @return the area of the rectangles with their shadow
+ */
+static uint32_t shadow_m_create(lv_obj_t * scr)
+{
+    return shadow_create(scr, &style_shadow_m, SHADOW_M);
+}
+
+/**
+ * Rectangles with large shadow
+ * @param scr pointer to the scene's screen
+ * @return the area of the rectangles with their shadow
+ */
+static uint32_t shadow_l_create(lv_obj_t * scr)
+{
+    return shadow_create(scr, &style_shadow_l, SHADOW_L);
+}
+
+/**
+ * The benchmark's background image tiled on the whole screen
+ * @param scr pointer to the scene's screen
+ * @return the area of the image
+ */
+static uint32_t img_create(lv_obj_t * scr)
+{
+    lv_style_copy(&style_img, &lv_style_plain);
+
+    return img_fill_create(scr, &style_img);
+}
+
+/**
+ * The benchmark's background image re-colored and tiled on the whole screen
+ * @param scr pointer to the scene's screen
+ * @return the area of the image
+ */
+static uint32_t img_recolor_create(lv_obj_t * scr)
+{
+    lv_style_copy(&style_img_recolor, &lv_style_plain);
+    style_img_recolor.image.color = LV_COLOR_RED;
+    style_img_recolor.image.intense = IMG_RECOLOR;
+
+    return img_fill_create(scr, &style_img_recolor);
+}
+
+/**
+ * Semi-transparent rectangles
+ * @param scr pointer to the scene's screen
+ * @return the area of the rectangles
+ */
+static uint32_t opa_create(lv_obj_t * scr)
+{
+    lv_style_copy(&style_opa, &lv_style_plain_color);
+    style_opa.body.radius = 0;
+    style_opa.body.opa = OPACITY;
+
+    return grid_create(scr, &style_opa, GRID_GAP);
+}
+
+#if LV_FONT_ROBOTO_12
+/**
+ * Text with 12 px font
+ * @param scr pointer to the scene's screen
+ * @return the area of the visible text
+ */
+static uint32_t text_12_create(lv_obj_t * scr)
+{
+    return text_create(scr, &style_text_12, &lv_font_roboto_12);
+}
+#endif
+
+#if LV_FONT_ROBOTO_16
+/**
+ * Text with 16 px font
+ * @param scr pointer to the scene's screen
+ * @return the area of the visible text
+ */
+static uint32_t text_16_create(lv_obj_t * scr)
+{
+    return text_create(scr, &style_text_16, &lv_font_roboto_16);
+}
+#endif
+
+#if LV_FONT_ROBOTO_22
+/**
+ * Text with 22 px font
+ * @param scr pointer to the scene's screen
+ * @return the area of the visible text
+ */
+static uint32_t text_22_create(lv_obj_t * scr)
+{
+    return text_create(scr, &style_text_22, &lv_font_roboto_22);
+}
+#endif
+
+#if LV_FONT_ROBOTO_28
+/**
+ * Text with 28 px font
+ * @param scr pointer to the scene's screen
+ * @return the area of the visible text
+ */
+static uint32_t text_28_create(lv_obj_t * scr)
+{
+    return text_create(scr, &style_text_28, &lv_font_roboto_28);
+}
+#endif
+
+/**
+ * Fill the screen with a grid of objects
+ * @param scr pointer to the scene's screen
+ * @param style style of the objects
+ * @param margin space around the objects
+ * @return the total area of the objects
+ */
+static uint32_t grid_create(lv_obj_t * scr, const lv_style_t * style, lv_coord_t margin)
+{
+    lv_coord_t hres = lv_disp_get_hor_res(NULL);
+    lv_coord_t vres = lv_disp_get_ver_res(NULL);
+    lv_coord_t cell_w = hres / GRID_COL;
+    lv_coord_t cell_h = vres / GRID_ROW;
+    lv_coord_t w = cell_w - 2 * margin;
+    lv_coord_t h = cell_h - 2 * margin;
+
+    uint16_t row;
+    uint16_t col;
+    for(row = 0; row < GRID_ROW; row++) {
+        for(col = 0; col < GRID_COL; col++) {
+            lv_obj_t * obj = lv_obj_create(scr, NULL);
+            lv_obj_set_style(obj, style);
+            lv_obj_set_size(obj, w, h);
+            lv_obj_set_pos(obj, col * cell_w + margin, row * cell_h + margin);
+        }
+    }
+
+    return (uint32_t)w * h * GRID_COL * GRID_ROW;
+}
+
+/**
+ * Fill the screen with a grid of objects with shadow
+ * @param scr pointer to the scene's screen
+ * @param style the style to initialize and use
+ * @param width width of the shadow. Limited to keep the objects `SHADOW_OBJ_MIN` large.
+ * @return the total area of the objects with their shadow or 0 if the screen is too small for the objects
+ */
+static uint32_t shadow_create(lv_obj_t * scr, lv_style_t * style, lv_coord_t width)
+{
+    lv_coord_t cell_w = lv_disp_get_hor_res(NULL) / GRID_COL;
+    lv_coord_t cell_h = lv_disp_get_ver_res(NULL) / GRID_ROW;
+    lv_coord_t width_max = (LV_MATH_MIN(cell_w, cell_h) - SHADOW_OBJ_MIN) / 2 - GRID_GAP;
+    if(width > width_max) width = width_max;
+    if(width < 0) width = 0;
+
+    /*Leave space for the shadow*/
+    lv_coord_t margin = width + GRID_GAP;
+    lv_coord_t w = cell_w - 2 * margin;
+    lv_coord_t h = cell_h - 2 * margin;
+    if(w <= 0 || h <= 0) return 0;
+
+    lv_style_copy(style, &lv_style_plain_color);
+    style->body.radius = 0;
+    style->body.shadow.width = width;
+    style->body.shadow.color = LV_COLOR_BLACK;
+
+    grid_create(scr, style, margin);
+
+    /*Count the area of the shadows too*/
+    return (uint32_t)(w + 2 * width) * (h + 2 * width) * GRID_COL * GRID_ROW;
+}
+
+/**
+ * Tile the benchmark's background image on the whole screen
+ * @param scr pointer to the scene's screen
+ * @param style style of the image
+ * @return the area of the image
+ */
+static uint32_t img_fill_create(lv_obj_t * scr, const lv_style_t * style)
+{
+    lv_coord_t hres = lv_disp_get_hor_res(NULL);
+    lv_coord_t vres = lv_disp_get_ver_res(NULL);
+
+    lv_obj_t * img = lv_img_create(scr, NULL);
+    lv_img_set_src(img, &benchmark_bg);
+    lv_img_set_auto_size(img, false);
+    lv_obj_set_size(img, hres, vres);
+    lv_img_set_style(img, LV_IMG_STYLE_MAIN, style);
+
+    return (uint32_t)hres * vres;
+}
+
+/**
+ * Fill the screen with wrapped text
+ * @param scr pointer to the scene's screen
+ * @param style the style to initialize and use
+ * @param font font of the text
+ * @return the visible area of the text
+ */
+static uint32_t text_create(lv_obj_t * scr, lv_style_t * style, const lv_font_t * font)
+{
+    lv_coord_t hres = lv_disp_get_hor_res(NULL);
+    lv_coord_t vres = lv_disp_get_ver_res(NULL);
+
+    lv_style_copy(style, &lv_style_plain);
+    style->text.font = font;
+
+    lv_obj_t * label = lv_label_create(scr, NULL);
+    lv_label_set_style(label, LV_LABEL_STYLE_MAIN, style);
+    lv_label_set_long_mode(label, LV_LABEL_LONG_BREAK);
+    lv_obj_set_width(label, hres);
+    lv_label_set_static_text(label, lorem_txt);
+
+    lv_coord_t h = lv_obj_get_height(label);
+    if(h > vres) h = vres;
+
+    return (uint32_t)hres * h;
+}
+
+#endif /*LV_USE_BENCHMARK*/
@@ -0,0 +1,209 @@
+/**
+ * @file lv_benchmark_task.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_benchmark_internal.h"
+#if LV_USE_BENCHMARK
+
+#include <stdint.h>
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define TASK_RUN_TIME       3000    /*Time of calling `lv_task_handler` with a number of tasks [ms]*/
+#define TASK_WARMUP_TIME    1000    /*Don't measure this long at the beginning (`lv_task_get_idle` needs 1 s to update) [ms]*/
+#define TASK_LOOP_IDLE      5000    /*Wait between the `lv_task_handler` calls like a main loop with `usleep(5000)` [us]*/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void dummy_task_cb(lv_task_t * task);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static const uint32_t def_nums[] = {10, 100, 1000, 10000};
+static const uint16_t periods[] = {10, 20, 50, 100, 200, 500, 1000};     /*[ms]*/
+static benchmark_task_result_t task_res[BENCHMARK_OBJ_RUN_MAX];
+static uint16_t task_res_cnt;
+static bool measure;                /*Save the delays of the tasks*/
+static uint32_t run_cnt;
+static uint64_t late_sum;
+static uint64_t late_sq_sum;
+static uint32_t late_max;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Measure how the cost of the task handler scales with the number of tasks.
+ * For each number that many tasks are created with mixed periods (10 ms to 1 s) and priorities.
+ * Then `lv_task_handler()` is called for a few seconds with a 5 ms wait between the calls (like in a main loop)
+ * and the following are measured:
+ * - the time of the `lv_task_handler()` calls (the tasks do nothing else than saving their delay)
+ * - the delay of the tasks compared to their period and its standard deviation (jitter)
+ * - the time spent outside of `lv_task_handler()` (true idle) and `lv_task_get_idle()` in the same time
+ * It calls `lv_task_handler()` itself so it should be called outside of it (e.g. from `main()`),
+ * not from an event or a task. The benchmark's screen should be idle (not running a test).
+ * @param nums the number of tasks to try in increasing order or NULL to use 10, 100, 1000, 10000
+ * @param cnt number of elements in `nums`. Limited to `BENCHMARK_OBJ_RUN_MAX`.
+ */
+void benchmark_run_tasks(const uint32_t * nums, uint16_t cnt)
+{
+    if(nums == NULL) {
+        nums = def_nums;
+        cnt = sizeof(def_nums) / sizeof(def_nums[0]);
+    }
+    if(cnt > BENCHMARK_OBJ_RUN_MAX) cnt = BENCHMARK_OBJ_RUN_MAX;
+
+    task_res_cnt = 0;
+    uint16_t i;
+    for(i = 0; i < cnt; i++) {
+        benchmark_task_result_t * res = &task_res[task_res_cnt];
+        memset(res, 0, sizeof(benchmark_task_result_t));
+        task_res_cnt++;
+
+        /*The tasks are deleted by their pointers*/
+        lv_task_t ** tasks = lv_mem_alloc(nums[i] * sizeof(lv_task_t *));
+        if(tasks == NULL) {
+            res->task_num = nums[i];
+            res->skipped = true;
+            continue;
+        }
+
+        uint32_t t;
+        for(t = 0; t < nums[i]; t++) {
+            if((t & BENCHMARK_MEM_CHECK_MASK) == 0 && benchmark_mem_is_enough(0) == false) break;
+
+            /*All the priorities from `LV_TASK_PRIO_LOWEST` to `LV_TASK_PRIO_HIGHEST`*/
+            lv_task_prio_t prio = LV_TASK_PRIO_LOWEST + t % (LV_TASK_PRIO_HIGHEST - LV_TASK_PRIO_LOWEST + 1);
+            uint16_t period = periods[t % (sizeof(periods) / sizeof(periods[0]))];
+            tasks[t] = lv_task_create(dummy_task_cb, period, prio, NULL);
+            if(tasks[t] == NULL) break;
+        }
+        res->task_num = t;
+
+        measure = false;
+        run_cnt = 0;
+        late_sum = 0;
+        late_sq_sum = 0;
+        late_max = 0;
+
+        uint64_t call_sum = 0;
+        uint64_t idle_sum = 0;
+        uint32_t idle_reported_sum = 0;
+        uint64_t start = benchmark_get_time_ns();
+        uint64_t measure_start = 0;
+        uint64_t now = start;
+        while(now - start < (uint64_t)TASK_RUN_TIME * 1000000) {
+            uint64_t call_start = benchmark_get_time_ns();
+            lv_task_handler();
+            uint64_t call_end = benchmark_get_time_ns();
+
+            /*Wait like an idle main loop*/
+            do {
+                now = benchmark_get_time_ns();
+            } while(now - call_end < (uint64_t)TASK_LOOP_IDLE * 1000);
+
+            if(measure == false) {
+                if(now - start < (uint64_t)TASK_WARMUP_TIME * 1000000) continue;
+                measure = true;
+                measure_start = now;
+                continue;
+            }
+
+            uint32_t call_time = (uint32_t)((call_end - call_start) / 1000);
+            call_sum += call_end - call_start;
+            if(call_time > res->call_max) res->call_max = call_time;
+            res->call_cnt++;
+
+            idle_sum += now - call_end;
+            idle_reported_sum += lv_task_get_idle();
+        }
+        measure = false;
+
+        uint32_t d;
+        for(d = 0; d < res->task_num; d++) lv_task_del(tasks[d]);
+        lv_mem_free(tasks);
+
+        if(res->call_cnt == 0) continue;
+
+        res->call_avg = (uint32_t)(call_sum / 1000 / res->call_cnt);
+        res->ns_per_task = res->task_num ? (uint32_t)(call_sum / res->call_cnt / res->task_num) : 0;
+        res->run_cnt = run_cnt;
+        if(run_cnt) {
+            res->late_avg = (uint32_t)(late_sum / run_cnt);
+            uint64_t var = late_sq_sum / run_cnt;
+            uint64_t avg_sq = (uint64_t)res->late_avg * res->late_avg;
+            res->jitter = benchmark_sqrt_u64(var > avg_sq ? var - avg_sq : 0);
+        }
+        res->late_max = late_max;
+
+        uint64_t measure_time = now - measure_start;
+        res->idle_true = measure_time ? (uint8_t)(idle_sum * 100 / measure_time) : 0;
+        res->idle_reported = (uint8_t)(idle_reported_sum / res->call_cnt);
+    }
+}
+
+/**
+ * Get the number of results of `benchmark_run_tasks()`
+ * @return number of results
+ */
+uint16_t benchmark_get_task_cnt(void)
+{
+    return task_res_cnt;
+}
+
+/**
+ * Get a result of `benchmark_run_tasks()`
+ * @param id index of the result
+ * @return pointer to the result or NULL if `id` is invalid
+ */
+const benchmark_task_result_t * benchmark_get_task_result(uint16_t id)
+{
+    if(id >= task_res_cnt) return NULL;
+
+    return &task_res[id];
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * The added tasks. Saves how much later it runs than its period.
+ * The time of the previous run is stored in `user_data` in microseconds (0: not run yet).
+ * @param task pointer to the task
+ */
+static void dummy_task_cb(lv_task_t * task)
+{
+    uint32_t now = (uint32_t)(benchmark_get_time_ns() / 1000);
+    if(now == 0) now = 1;
+
+    uint32_t prev = (uint32_t)(uintptr_t)task->user_data;
+    task->user_data = (void *)(uintptr_t)now;
+    if(prev == 0 || measure == false) return;
+
+    uint32_t elapsed = now - prev;
+    uint32_t late = elapsed > task->period * 1000 ? elapsed - task->period * 1000 : 0;
+    late_sum += late;
+    late_sq_sum += (uint64_t)late * late;
+    if(late > late_max) late_max = late;
+    run_cnt++;
+}
+
+#endif /*LV_USE_BENCHMARK*/
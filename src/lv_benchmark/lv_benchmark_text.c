@@ -0,0 +1,349 @@
+/**
+ * @file lv_benchmark_text.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_benchmark.h"
+#if LV_USE_BENCHMARK
+
+#include <stdio.h>
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define TEXT_BUF_SIZE       2048
+#define WRAP_SHIFT          7       /*Rotate the text by this many characters on every refresh*/
+#define TERM_LOG_LENGTH     1024    /*Characters kept in the terminal's log*/
+#define SET_TEXT_LABEL_NUM  32
+#define SET_TEXT_COL_NUM    4
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#if LV_FONT_ROBOTO_12
+static uint32_t wrap_12_create(lv_obj_t * scr);
+#endif
+#if LV_FONT_ROBOTO_16
+static uint32_t wrap_16_create(lv_obj_t * scr);
+#endif
+#if LV_FONT_ROBOTO_22
+static uint32_t wrap_22_create(lv_obj_t * scr);
+#endif
+#if LV_FONT_ROBOTO_28
+static uint32_t wrap_28_create(lv_obj_t * scr);
+#endif
+static uint32_t recolor_create(lv_obj_t * scr);
+static uint32_t terminal_create(lv_obj_t * scr);
+static uint32_t set_text_create(lv_obj_t * scr);
+static void wrap_update(uint32_t frame);
+static void recolor_update(uint32_t frame);
+static void terminal_update(uint32_t frame);
+static void set_text_update(uint32_t frame);
+static uint32_t wrap_create(lv_obj_t * scr, const lv_font_t * font);
+static lv_obj_t * break_label_create(lv_obj_t * scr, const lv_font_t * font);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static const benchmark_scene_t text_scenes[] = {
+#if LV_FONT_ROBOTO_12
+    {"wrap_12", wrap_12_create, wrap_update},
+#endif
+#if LV_FONT_ROBOTO_16
+    {"wrap_16", wrap_16_create, wrap_update},
+#endif
+#if LV_FONT_ROBOTO_22
+    {"wrap_22", wrap_22_create, wrap_update},
+#endif
+#if LV_FONT_ROBOTO_28
+    {"wrap_28", wrap_28_create, wrap_update},
+#endif
+    {"recolor", recolor_create, recolor_update},
+    {"terminal", terminal_create, terminal_update},
+    {"set_text", set_text_create, set_text_update},
+};
+
+static const char * sample_txt =
+    "The quick brown fox jumps over the lazy dog. Pack my box with five dozen liquor jugs. "
+    "How vexingly quick daft zebras jump! Sphinx of black quartz, judge my vow. ";
+
+static lv_style_t style_text;
+static char text_buf[TEXT_BUF_SIZE];
+static uint32_t text_len;
+static lv_obj_t * text_label;
+static lv_obj_t * set_text_labels[SET_TEXT_LABEL_NUM];
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Get the scenes which change and re-wrap text before every refresh (long texts with several fonts,
+ * recolored text, a terminal-like log, many `lv_label_set_text`). Use them with `benchmark_start_scenes()`.
+ * @param cnt store the number of scenes here
+ * @return the array of scenes
+ */
+const benchmark_scene_t * benchmark_get_text_scenes(uint16_t * cnt)
+{
+    *cnt = sizeof(text_scenes) / sizeof(text_scenes[0]);
+    return text_scenes;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_FONT_ROBOTO_12
+/**
+ * Long wrapped text with a small font
+ * @param scr pointer to the scene's screen
+ * @return 0: the costs are per character, not per pixel
+ */
+static uint32_t wrap_12_create(lv_obj_t * scr)
+{
+    return wrap_create(scr, &lv_font_roboto_12);
+}
+#endif
+
+#if LV_FONT_ROBOTO_16
+/**
+ * Long wrapped text with a normal font
+ * @param scr pointer to the scene's screen
+ * @return 0: the costs are per character, not per pixel
+ */
+static uint32_t wrap_16_create(lv_obj_t * scr)
+{
+    return wrap_create(scr, &lv_font_roboto_16);
+}
+#endif
+
+#if LV_FONT_ROBOTO_22
+/**
+ * Long wrapped text with a large font
+ * @param scr pointer to the scene's screen
+ * @return 0: the costs are per character, not per pixel
+ */
+static uint32_t wrap_22_create(lv_obj_t * scr)
+{
+    return wrap_create(scr, &lv_font_roboto_22);
+}
+#endif
+
+#if LV_FONT_ROBOTO_28
+/**
+ * Long wrapped text with a huge font
+ * @param scr pointer to the scene's screen
+ * @return 0: the costs are per character, not per pixel
+ */
+static uint32_t wrap_28_create(lv_obj_t * scr)
+{
+    return wrap_create(scr, &lv_font_roboto_28);
+}
+#endif
+
+/**
+ * Blocks of recolored text like the system monitor's
+ * @param scr pointer to the scene's screen
+ * @return 0: the costs are per character, not per pixel
+ */
+static uint32_t recolor_create(lv_obj_t * scr)
+{
+    text_label = break_label_create(scr, LV_FONT_DEFAULT);
+    lv_label_set_recolor(text_label, true);
+    recolor_update(0);
+
+    return 0;
+}
+
+/**
+ * A terminal-like log which gets a new line on every refresh
+ * @param scr pointer to the scene's screen
+ * @return 0: the costs are per character, not per pixel
+ */
+static uint32_t terminal_create(lv_obj_t * scr)
+{
+    text_label = break_label_create(scr, LV_FONT_DEFAULT);
+    text_buf[0] = '\0';
+    text_len = 0;
+
+    /*Fill the log*/
+    uint32_t i;
+    for(i = 0; text_len < TERM_LOG_LENGTH / 2; i++) terminal_update(i);
+
+    return 0;
+}
+
+/**
+ * Many short labels updated with `lv_label_set_text()`
+ * @param scr pointer to the scene's screen
+ * @return 0: the costs are per character, not per pixel
+ */
+static uint32_t set_text_create(lv_obj_t * scr)
+{
+    lv_coord_t hres = lv_disp_get_hor_res(NULL);
+    lv_coord_t vres = lv_disp_get_ver_res(NULL);
+    lv_coord_t cell_w = hres / SET_TEXT_COL_NUM;
+    lv_coord_t cell_h = vres / (SET_TEXT_LABEL_NUM / SET_TEXT_COL_NUM);
+
+    uint16_t i;
+    for(i = 0; i < SET_TEXT_LABEL_NUM; i++) {
+        lv_obj_t * label = lv_label_create(scr, NULL);
+        lv_obj_set_pos(label, (i % SET_TEXT_COL_NUM) * cell_w, (i / SET_TEXT_COL_NUM) * cell_h);
+        set_text_labels[i] = label;
+    }
+
+    set_text_update(0);
+
+    return 0;
+}
+
+/**
+ * Rotate the text so it's wrapped differently on every refresh
+ * @param frame index of the next refresh
+ */
+static void wrap_update(uint32_t frame)
+{
+    uint32_t sample_len = strlen(sample_txt);
+    uint32_t i;
+    for(i = 0; i < text_len; i++) {
+        text_buf[i] = sample_txt[(i + frame * WRAP_SHIFT) % sample_len];
+    }
+    text_buf[text_len] = '\0';
+
+    lv_label_set_text(text_label, text_buf);
+}
+
+/**
+ * Write new values into the recolored text
+ * @param frame index of the next refresh
+ */
+static void recolor_update(uint32_t frame)
+{
+    lv_coord_t vres = lv_disp_get_ver_res(NULL);
+    const lv_font_t * font = LV_FONT_DEFAULT;
+
+    /*A block has 7 lines, add as many as fit to the screen*/
+    uint32_t block_num = vres / (7 * lv_font_get_line_height(font)) + 1;
+    uint32_t len = 0;
+    uint32_t i;
+    for(i = 0; i < block_num && len < TEXT_BUF_SIZE - 256; i++) {
+        uint32_t v = frame + i * 13;
+        len += sprintf(&text_buf[len], LV_TXT_COLOR_CMD"FF0000 CPU: %d %%"LV_TXT_COLOR_CMD"\n"
+                       LV_TXT_COLOR_CMD"0000FF MEMORY: %d %%"LV_TXT_COLOR_CMD"\n"
+                       "Total: %d bytes\n"
+                       "Used: %d bytes\n"
+                       "Free: %d bytes\n"
+                       "Frag: %d %%\n\n",
+                       (int)(v % 100), (int)((v * 7) % 100),
+                       65536, (int)((v * 331) % 65536), (int)(65536 - (v * 331) % 65536), (int)((v * 3) % 100));
+    }
+
+    lv_label_set_text(text_label, text_buf);
+    benchmark_set_scene_char_cnt(len);
+}
+
+/**
+ * Add a new line to the terminal's log and drop the oldest lines if it's full
+ * @param frame index of the next refresh
+ */
+static void terminal_update(uint32_t frame)
+{
+    char line[64];
+    uint32_t line_len = sprintf(line, "[%d] Received %d bytes from 192.168.0.%d\n",
+                                (int)frame, (int)((frame * 37) % 1500), (int)(frame % 254 + 1));
+
+    /*Drop the oldest lines like lv_terminal*/
+    if(text_len + line_len > TERM_LOG_LENGTH) {
+        uint32_t drop = 0;
+        while(drop < text_len && (text_len - drop + line_len > TERM_LOG_LENGTH || text_buf[drop] != '\n')) drop++;
+        if(drop < text_len) drop++;     /*Drop the new line character too*/
+
+        memmove(text_buf, &text_buf[drop], text_len - drop);
+        text_len -= drop;
+    }
+
+    memcpy(&text_buf[text_len], line, line_len);
+    text_len += line_len;
+    text_buf[text_len] = '\0';
+
+    lv_label_set_static_text(text_label, text_buf);
+    benchmark_set_scene_char_cnt(text_len);
+}
+
+/**
+ * Set a new text on all the labels
+ * @param frame index of the next refresh
+ */
+static void set_text_update(uint32_t frame)
+{
+    uint32_t len = 0;
+    uint16_t i;
+    for(i = 0; i < SET_TEXT_LABEL_NUM; i++) {
+        char buf[32];
+        len += sprintf(buf, "Value %d: %d", i, (int)((frame * (i + 1)) % 10000));
+        lv_label_set_text(set_text_labels[i], buf);
+    }
+
+    benchmark_set_scene_char_cnt(len);
+}
+
+/**
+ * Fill the screen with wrapped text. Only as much text is used as fits to the screen.
+ * @param scr pointer to the scene's screen
+ * @param font font of the text
+ * @return 0: the costs are per character, not per pixel
+ */
+static uint32_t wrap_create(lv_obj_t * scr, const lv_font_t * font)
+{
+    lv_coord_t vres = lv_disp_get_ver_res(NULL);
+
+    text_label = break_label_create(scr, font);
+
+    /*Set a long text and cut it where it leaves the screen*/
+    text_len = TEXT_BUF_SIZE - 1;
+    wrap_update(0);
+    if(lv_obj_get_height(text_label) > vres) {
+        lv_point_t p;
+        p.x = lv_obj_get_width(text_label) - 1;
+        p.y = vres - 1;
+        text_len = lv_label_get_letter_on(text_label, &p);  /*The text is ASCII so letter index = byte index*/
+        wrap_update(0);
+    }
+
+    benchmark_set_scene_char_cnt(text_len);
+
+    return 0;
+}
+
+/**
+ * Create a label with `LV_LABEL_LONG_BREAK` on the whole width of the screen
+ * @param scr pointer to the scene's screen
+ * @param font font of the text
+ * @return pointer to the label
+ */
+static lv_obj_t * break_label_create(lv_obj_t * scr, const lv_font_t * font)
+{
+    lv_style_copy(&style_text, &lv_style_plain);
+    style_text.text.font = font;
+
+    lv_obj_t * label = lv_label_create(scr, NULL);
+    lv_label_set_style(label, LV_LABEL_STYLE_MAIN, &style_text);
+    lv_label_set_long_mode(label, LV_LABEL_LONG_BREAK);
+    lv_obj_set_width(label, lv_disp_get_hor_res(NULL));
+
+    return label;
+}
+
+#endif /*LV_USE_BENCHMARK*/